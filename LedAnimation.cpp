@@ -0,0 +1,100 @@
+/*
+ *    LedAnimation.cpp - Plays animations stored in flash without
+ *    blocking the sketch
+ *
+ *    Released under the same terms as LedControl.h
+ */
+
+#include "LedAnimation.h"
+
+LedAnimation::LedAnimation(LedControl &lc, int addr)
+    : canvas(lc,addr) {
+    init();
+}
+
+LedAnimation::LedAnimation(const LedCanvas &canvas)
+    : canvas(canvas) {
+    init();
+}
+
+void LedAnimation::init() {
+    data=0;
+    next=0;
+    devices=0;
+    loop=false;
+    duration=0;
+    last=0;
+    running=false;
+}
+
+void LedAnimation::start(const byte *animation, bool loop) {
+    data=animation;
+    devices=pgm_read_byte(animation);
+    next=animation+1;
+    this->loop=loop;
+    running=load();
+    canvas.show();
+    last=millis();
+}
+
+unsigned int LedAnimation::readDuration() {
+    //low byte first, like LEDANIM_FRAME stores it
+    return pgm_read_byte(next)|((unsigned int)pgm_read_byte(next+1)<<8);
+}
+
+bool LedAnimation::load() {
+    byte mask;
+    bool first;
+
+    duration=readDuration();
+    if(duration==0) {
+	if(!loop || next==data+1)
+	    return false;
+	//start over, the first frame has to clear what the last one left
+	next=data+1;
+	duration=readDuration();
+    }
+    first=(next==data+1);
+    next+=2;
+    for(int d=0;d<devices;d++) {
+	mask=pgm_read_byte(next++);
+	for(int r=0;r<8;r++) {
+	    //the canvas ignores devices it does not have, and only marks rows that change
+	    if(mask&(1<<r))
+		canvas.setColumn(d*8+r,pgm_read_byte(next++));
+	    else if(first)
+		canvas.setColumn(d*8+r,0x00);
+	}
+    }
+    return true;
+}
+
+bool LedAnimation::update() {
+    unsigned long now;
+    LEDCONTROL_STAT(unsigned long start=LEDCONTROL_CYCLES();)
+
+    if(!running)
+	return false;
+    now=millis();
+    if(now-last<duration)
+	return true;
+    //catch up with the clock, frames we missed only change the led-status
+    while(now-last>=duration) {
+	last+=duration;
+	if(!load()) {
+	    running=false;
+	    break;
+	}
+    }
+    canvas.show();
+    LEDCONTROL_STAT(canvas.getControl().countFrame(LEDCONTROL_CYCLES()-start);)
+    return running;
+}
+
+void LedAnimation::stop() {
+    running=false;
+}
+
+bool LedAnimation::isFinished() {
+    return !running;
+}
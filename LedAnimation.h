@@ -0,0 +1,121 @@
+/*
+ *    LedAnimation.h - Plays animations stored in flash without
+ *    blocking the sketch
+ *
+ *    Released under the same terms as LedControl.h
+ */
+
+#ifndef LedAnimation_h
+#define LedAnimation_h
+
+#include "LedControl.h"
+#include "LedCanvas.h"
+
+/*
+ * An animation only stores the rows that change from one frame to the
+ * next. It is a byte array in PROGMEM laid out like this:
+ *
+ *   number of devices
+ *   for every frame:
+ *     LEDANIM_FRAME(ms)	how long the frame is shown
+ *     for every device:
+ *       a mask, bit R is set if row R changes
+ *       the new value of every row set in the mask, row 0 first
+ *   LEDANIM_END
+ *
+ * A row is what LedControl::setRow() takes, one column of the matrix.
+ * The first frame starts from a blank display, rows missing from its
+ * mask are switched off. An example with one device, a dot that
+ * moves right and back:
+ *
+ *   const byte punto[] PROGMEM = {
+ *     1,
+ *     LEDANIM_FRAME(200), 0x01, 0x18,
+ *     LEDANIM_FRAME(200), 0x03, 0x00, 0x18,
+ *     LEDANIM_END
+ *   };
+ */
+
+/* The duration of a frame in milliseconds, 1 to 65535 */
+#define LEDANIM_FRAME(ms) (byte)((ms)&0xFF),(byte)(((ms)>>8)&0xFF)
+/* Marks the end of the animation, a frame that takes 0 milliseconds */
+#define LEDANIM_END 0,0
+
+/*
+ * An animation in progress. update() is called from loop() and moves
+ * on to the next frame when it is due. The rows of a frame are read
+ * from flash straight into the led-status, only rows that actually
+ * change are sent to the devices.
+ */
+class LedAnimation {
+ private :
+    /* The modules we draw on, device N of the animation is module N */
+    LedCanvas canvas;
+    /* The animation in flash and the next frame to show */
+    const byte *data;
+    const byte *next;
+    /* Number of devices stored in every frame */
+    byte devices;
+    /* true to start over after the last frame */
+    bool loop;
+    /* Milliseconds the frame on the display is shown */
+    unsigned long duration;
+    /* millis() when the current frame was shown */
+    unsigned long last;
+    /* true while there are frames left */
+    bool running;
+
+    /* Setup the state shared by the constructors */
+    void init();
+    /* The duration of the frame at next */
+    unsigned int readDuration();
+    /*
+     * Draw the next frame into the led-status.
+     * Returns :
+     * bool	false if the animation is over
+     */
+    bool load();
+
+ public:
+    /*
+     * Params :
+     * lc	the controler to draw on
+     * addr	address of the device that shows the first device of
+     *		the animation
+     */
+    LedAnimation(LedControl &lc, int addr=0);
+
+    /*
+     * Params :
+     * canvas	the modules to draw on
+     */
+    LedAnimation(const LedCanvas &canvas);
+
+    /*
+     * Start an animation, the first frame is drawn right away.
+     * Params :
+     * animation	the animation in PROGMEM, it is not copied
+     * loop		if true the animation starts over after the last frame
+     */
+    void start(const byte *animation, bool loop=false);
+
+    /*
+     * Show the next frame if it is due. If the sketch fell behind,
+     * the missed frames are skipped and only the rows that differ
+     * from what the display shows are sent. Returns immediately.
+     * Returns :
+     * bool	true while the animation is running
+     */
+    bool update();
+
+    /* Stop the animation, the display keeps the current frame */
+    void stop();
+
+    /*
+     * Returns :
+     * bool	true once the last frame was shown for its full time
+     */
+    bool isFinished();
+};
+
+#endif	//LedAnimation.h
@@ -0,0 +1,120 @@
+/*
+ *    LedCanvas.cpp - One wide drawing area over several LED matrices
+ *    of a LedControl chain
+ *
+ *    Released under the same terms as LedControl.h
+ */
+
+#include "LedCanvas.h"
+#include "LedText.h"
+
+LedCanvas::LedCanvas(LedControl &lc, int first, int count, bool reversed) {
+    this->lc=&lc;
+    if(first<0 || first>=lc.getDeviceCount()) {
+	//an empty canvas, nothing is ever drawn
+	first=0;
+	count=0;
+    }
+    else if(count<0 || first+count>lc.getDeviceCount())
+	count=lc.getDeviceCount()-first;
+    this->first=first;
+    this->count=count;
+    this->reversed=reversed;
+}
+
+LedDevice LedCanvas::module(int m) {
+    return lc->device(reversed ? first+count-1-m : first+m);
+}
+
+int LedCanvas::getWidth() {
+    return count*8;
+}
+
+void LedCanvas::setColumn(int x, byte value) {
+    if(x<0 || x>=count*8)
+	return;
+    //the columns of the matrix are the rows of the MAX7219
+    module(x/8).setRow(x%8,value);
+}
+
+byte LedCanvas::getColumn(int x) {
+    if(x<0 || x>=count*8)
+	return 0x00;
+    return module(x/8).getRow(x%8);
+}
+
+void LedCanvas::clear() {
+    for(int m=0;m<count;m++)
+	module(m).clear();
+}
+
+void LedCanvas::printString(int x, const char string[], int length, bool proportional) {
+    LedTextColumns columns;
+    int from, to;
+
+    if(length<0) {
+	length=0;
+	while(string[length]!='\0')
+	    length++;
+    }
+    //clip the columns of the text to the canvas
+    from=x<0 ? 0 : x;
+    to=x+ledTextWidth(string,length,proportional)-1;
+    if(to>=count*8)
+	to=count*8-1;
+    columns.start(string,length,from-x,false,proportional);
+    for(int c=from;c<=to;c++)
+	setColumn(c,columns.next());
+}
+
+void LedCanvas::blit(int x, int y, LedSprite sprite, byte op) {
+    //the module under the left edge, rounded down for negative columns
+    int m=x>=0 ? x/8 : -((7-x)/8);
+
+    //the sprite covers at most this module and the next one
+    for(int i=m;i<=m+1;i++) {
+	if(i>=0 && i<count)
+	    module(i).blit(sprite,x-i*8,y,op);
+    }
+}
+
+void LedCanvas::scrollColumn(byte value, char sentido) {
+    LedDevice current, next;
+
+    if(count==0)
+	return;
+    if(sentido=='<') {
+	current=module(0);
+	for(int m=0;m<count;m++) {
+	    for(int c=0;c<7;c++)
+		current.setRow(c,current.getRow(c+1));
+	    //the left column of the next module moves over to this one
+	    if(m+1<count) {
+		next=module(m+1);
+		current.setRow(7,next.getRow(0));
+		current=next;
+	    }
+	    else
+		current.setRow(7,value);
+	}
+    }
+    else {
+	current=module(count-1);
+	for(int m=count-1;m>=0;m--) {
+	    for(int c=7;c>0;c--)
+		current.setRow(c,current.getRow(c-1));
+	    if(m>0) {
+		next=module(m-1);
+		current.setRow(0,next.getRow(7));
+		current=next;
+	    }
+	    else
+		current.setRow(0,value);
+	}
+    }
+}
+
+void LedCanvas::show() {
+    if(!lc->isDeferred())
+	lc->flush();
+}
@@ -0,0 +1,107 @@
+/*
+ *    LedCanvas.h - One wide drawing area over several LED matrices
+ *    of a LedControl chain
+ *
+ *    Released under the same terms as LedControl.h
+ */
+
+#ifndef LedCanvas_h
+#define LedCanvas_h
+
+#include "LedControl.h"
+
+/*
+ * A horizontal canvas over a run of devices in the chain. Column x of
+ * the canvas is column x%8 of the (x/8)th device, so text drawn on the 
+ * canvas flows from one module into the next. Drawing only changes the
+ * led-status, show() sends all changed rows of the chain together, one
+ * latch per row.
+ */
+class LedCanvas {
+ private :
+    /* The controler we draw on */
+    LedControl *lc;
+    /* The first device and the number of devices of the canvas */
+    int first;
+    int count;
+    /* If true device first is the rightmost module instead of the leftmost */
+    bool reversed;
+
+    /* The device that shows module m of the canvas, counted from the left */
+    LedDevice module(int m);
+
+ public:
+    /* 
+     * Params :
+     * lc	the controler to draw on
+     * first	address of the first device of the canvas
+     * count	number of devices, -1 for all devices from first on
+     * reversed	set to true if the first device is the rightmost 
+     *		module of the display
+     */
+    LedCanvas(LedControl &lc, int first=0, int count=-1, bool reversed=false);
+
+    /*
+     * Returns :
+     * int	the number of columns of the canvas, 8 for every device
+     */
+    int getWidth();
+
+    /* 
+     * Set a column of the canvas, columns outside are ignored.
+     * Params :
+     * x	the column, 0 is the left edge
+     * value	bit 0 is the top led
+     */
+    void setColumn(int x, byte value);
+
+    /* 
+     * Get a column of the canvas, columns outside are blank
+     * Params :
+     * x	the column, 0 is the left edge
+     */
+    byte getColumn(int x);
+
+    /* Switch all leds of the canvas off */
+    void clear();
+
+    /*
+     * Draw a string like LedControl::printString, only the part that
+     * falls on the canvas is drawn.
+     * Params :
+     * x	column where the first character starts, may be negative
+     * string	the text to draw, UTF-8
+     * length	number of bytes in string, -1 if it is unknown
+     * proportional	if true every character only takes the width 
+     *			of its glyph, see LedTextColumns
+     */
+    void printString(int x, const char string[], int length=-1, bool proportional=false);
+
+    /*
+     * Move the whole canvas by one column, see LedControl::scrollColumn()
+     * Params :
+     * value	the new column
+     * sentido	'<' moves to the left and value ends up at the right 
+     *		edge, '>' moves to the right
+     */
+    void scrollColumn(byte value, char sentido);
+
+    /*
+     * Draw a sprite on the canvas. A sprite that straddles two modules
+     * is drawn on both, each with a single word operation.
+     * Params :
+     * x	column of the canvas where the left edge of the sprite goes
+     * y	row where the top of the sprite goes, may be negative
+     * sprite	the sprite
+     * op	LEDSPRITE_COPY, LEDSPRITE_OR, LEDSPRITE_AND or LEDSPRITE_XOR
+     */
+    void blit(int x, int y, LedSprite sprite, byte op=LEDSPRITE_OR);
+
+    /* The controler the canvas draws on */
+    LedControl &getControl() { return *lc; }
+
+    /* Send everything that changed, unless the controler is in deferred mode */
+    void show();
+};
+
+#endif	//LedCanvas.h
@@ -26,6 +26,8 @@
  
 
 #include "LedControl.h"
+#include "LedFont.h"
+#include "LedText.h"
 
 //the opcodes for the MAX7221 and MAX7219
 #define OP_NOOP   0
@@ -43,30 +45,95 @@
 #define OP_SHUTDOWN    12
 #define OP_DISPLAYTEST 15
 
-LedControl::LedControl(int dataPin, int clkPin, int csPin, int numDevices) {
-    SPI_MOSI=dataPin;
-    SPI_CLK=clkPin;
-    SPI_CS=csPin;
+LedControl::LedControl(int dataPin, int clkPin, int csPin, int numDevices) 
+    : pins(dataPin,clkPin,csPin) {
+    allocate(numDevices);
+    transport=&pins;
+    init();
+}
+
+LedControl::LedControl(LedTransport &t, int numDevices) 
+    : pins(-1,-1,-1) {
+    allocate(numDevices);
+    transport=&t;
+    init();
+}
+
+LedControl::LedControl(int dataPin, int clkPin, int csPin, LedTransport *t, 
+		       int numDevices, byte *statusBuffer, byte *spiBuffer, byte *dirtyBuffer,
+		       LedDeviceControl *controlBuffer) 
+    : pins(dataPin,clkPin,csPin) {
+    maxDevices=numDevices;
+    status=statusBuffer;
+    spidata=spiBuffer;
+    dirty=dirtyBuffer;
+    control=controlBuffer;
+    ownsBuffers=false;
+    transport=t!=0 ? t : &pins;
+    init();
+}
+
+void LedControl::allocate(int numDevices) {
     if(numDevices<=0 || numDevices>8 )
 	numDevices=8;
     maxDevices=numDevices;
-    pinMode(SPI_MOSI,OUTPUT);
-    pinMode(SPI_CLK,OUTPUT);
-    pinMode(SPI_CS,OUTPUT);
-    digitalWrite(SPI_CS,HIGH);
-    SPI_MOSI=dataPin;
-    for(int i=0;i<64;i++) 
+    //only what the chain needs, a single module costs 20 bytes
+    status=new byte[maxDevices*8];
+    spidata=new byte[maxDevices*2];
+    dirty=new byte[maxDevices];
+    control=new LedDeviceControl[maxDevices];
+    ownsBuffers=true;
+}
+
+LedControl::~LedControl() {
+    //both send what is pending, so they go before the arrays
+    setQueued(false);
+    setDoubleBuffer(false);
+    if(ownsBuffers) {
+	delete[] status;
+	delete[] spidata;
+	delete[] dirty;
+	delete[] control;
+    }
+    LEDCONTROL_STAT(delete[] deviceLatches;)
+}
+
+void LedControl::init() {
+#if LEDCONTROL_STATS
+    deviceLatches=new unsigned long[maxDevices];
+    resetStats();
+#endif
+    transport->begin();
+    for(int i=0;i<maxDevices*8;i++) 
 	status[i]=0x00;
     for(int i=0;i<maxDevices;i++) {
-	spiTransfer(i,OP_DISPLAYTEST,0);
-	//scanlimit is set to max on startup
-	setScanLimit(i,7);
-	//decode is done in source
-	spiTransfer(i,OP_DECODEMODE,0);
-	clearDisplay(i);
-	//we go into shutdown-mode on startup
-	shutdown(i,true);
+	dirty[i]=0x00;
+	//the control registers are all 0 after power-up, init() sets the rest
+	for(int r=0;r<4;r++) {
+	    control[i].value[r]=0;
+	    control[i].requested[r]=0;
+	}
+	control[i].pending=0;
     }
+    deferred=false;
+    frame=status;
+    backBuffer=0;
+    scrubNext=0;
+    transaction=false;
+    deferredMode=false;
+    powerSaving=false;
+    powerBudget=0;
+    queued=0;
+    //every command goes to all devices at once, 12 latches for any chain
+    spiBroadcast(OP_DISPLAYTEST,0);
+    //scanlimit is set to max on startup
+    setScanLimitAll(7);
+    //decode is done in source
+    spiBroadcast(OP_DECODEMODE,0);
+    for(int row=0;row<8;row++)
+	spiBroadcast(row+1,0);
+    //we go into shutdown-mode on startup
+    shutdownAll(true);
 }
 
 int LedControl::getDeviceCount() {
@@ -77,937 +144,795 @@ void LedControl::shutdown(int addr, bool b) {
     if(addr<0 || addr>=maxDevices)
 	return;
     if(b)
-	spiTransfer(addr, OP_SHUTDOWN,0);
+	setControl(addr, OP_SHUTDOWN,0);
     else
-	spiTransfer(addr, OP_SHUTDOWN,1);
+	setControl(addr, OP_SHUTDOWN,1);
 }
 	
 void LedControl::setScanLimit(int addr, int limit) {
     if(addr<0 || addr>=maxDevices)
 	return;
     if(limit>=0 || limit<8)
-    	spiTransfer(addr, OP_SCANLIMIT,limit);
+    	setControl(addr, OP_SCANLIMIT,limit);
 }
 
 void LedControl::setIntensity(int addr, int intensity) {
     if(addr<0 || addr>=maxDevices)
 	return;
     if(intensity>=0 || intensity<16)	
-	spiTransfer(addr, OP_INTENSITY,intensity);
+	setControl(addr, OP_INTENSITY,intensity);
     
 }
 
-void LedControl::clearDisplay(int addr) {
-    int offset;
+void LedControl::shutdownAll(bool b) {
+    setControlAll(OP_SHUTDOWN,b ? 0 : 1);
+}
 
-    if(addr<0 || addr>=maxDevices)
+void LedControl::setScanLimitAll(int limit) {
+    if(limit>=0 && limit<8)
+	setControlAll(OP_SCANLIMIT,limit);
+}
+
+void LedControl::setIntensityAll(int intensity) {
+    if(intensity>=0 && intensity<16)
+	setControlAll(OP_INTENSITY,intensity);
+}
+
+void LedControl::setControl(int addr, byte opcode, byte data) {
+    control[addr].requested[opcode-OP_DECODEMODE]=data;
+    if(!powerSaving) {
+	spiTransfer(addr,opcode,data);
 	return;
-    offset=addr*8;
-    for(int i=0;i<8;i++) {
-	status[offset+i]=0;
-	spiTransfer(addr, i+1,status[offset+i]);
     }
+    updatePower(addr);
+    if(!transaction)
+	sendControl(addr);
 }
 
-void LedControl::setLed(int addr, int row, int column, boolean state) {
-    int offset;
-    byte val=0x00;
+void LedControl::setControlAll(byte opcode, byte data) {
+    if(!powerSaving) {
+	for(int addr=0;addr<maxDevices;addr++)
+	    control[addr].requested[opcode-OP_DECODEMODE]=data;
+	spiBroadcast(opcode,data);
+	return;
+    }
+    for(int addr=0;addr<maxDevices;addr++) {
+	control[addr].requested[opcode-OP_DECODEMODE]=data;
+	updatePower(addr);
+    }
+    if(!transaction)
+	sendPending(false);
+}
+
+void LedControl::setPowerSaving(bool enable, int budget) {
+    powerSaving=enable;
+    powerBudget=budget>0 ? budget : 0;
+    for(int addr=0;addr<maxDevices;addr++) {
+	if(enable)
+	    updatePower(addr);
+	else {
+	    for(int i=1;i<4;i++)
+		changeControl(addr,OP_DECODEMODE+i,control[addr].requested[i]);
+	}
+    }
+    if(!transaction)
+	sendPending(false);
+}
+
+void LedControl::changeControl(int addr, byte opcode, byte data) {
+    if(control[addr].value[opcode-OP_DECODEMODE]==data)
+	return;
+    control[addr].value[opcode-OP_DECODEMODE]=data;
+    control[addr].pending|=1<<(opcode-OP_DECODEMODE);
+}
+
+void LedControl::updatePower(int addr) {
+    byte *requested=control[addr].requested;
+    byte *rows=status+addr*8;
+    int lit=0, last=-1, limit;
+    long duty, cap;
+
+    for(int row=0;row<8;row++) {
+	if(rows[row]!=0)
+	    last=row;
+	//one step for every lit led
+	for(byte value=rows[row];value!=0;value&=value-1)
+	    lit++;
+    }
+    if(last<0) {
+	//nothing to show, the other registers are set when it wakes up
+	changeControl(addr,OP_SHUTDOWN,0);
+	return;
+    }
+    //the datasheet warns about scan limits of 3 digits or less
+    if(last<3)
+	last=3;
+    limit=requested[OP_SCANLIMIT-OP_DECODEMODE];
+    if(last<limit)
+	limit=last;
+    //intensity N lights a digit for (2N+1)/32 of its time slot, and a 
+    //slot gets longer as the scan limit drops, so the duty is scaled
+    //down with it to keep the same brightness
+    duty=(2L*requested[OP_INTENSITY-OP_DECODEMODE]+1)*(limit+1)/(requested[OP_SCANLIMIT-OP_DECODEMODE]+1);
+    if(powerBudget>0) {
+	//the current of the budget at intensity 15 with all 8 digits
+	cap=31L*powerBudget*(limit+1)/(8L*lit);
+	if(cap<duty)
+	    duty=cap;
+    }
+    changeControl(addr,OP_SCANLIMIT,limit);
+    changeControl(addr,OP_INTENSITY,duty>1 ? (duty-1)/2 : 0);
+    //last, so a device that wakes up starts with the new values
+    changeControl(addr,OP_SHUTDOWN,requested[OP_SHUTDOWN-OP_DECODEMODE]);
+}
+
+void LedControl::clearDisplay(int addr) {
+    if(addr<0 || addr>=maxDevices)
+	return;
+    //rows that are already blank are not sent
+    device(addr).clear();
+    updateDevice(addr);
+}
 
+void LedControl::setLed(int addr, int row, int column, boolean state) {
     if(addr<0 || addr>=maxDevices)
 	return;
     if(row<0 || row>7 || column<0 || column>7)
 	return;
-    offset=addr*8;
-    val=B10000000 >> column;
-    if(state)
-	status[offset+row]=status[offset+row]|val;
-    else {
-	val=~val;
-	status[offset+row]=status[offset+row]&val;
-    }
-    spiTransfer(addr, row+1,status[offset+row]);
+    device(addr).setLed(row,column,state);
+    updateRow(addr,row);
 }
 	
 void LedControl::setRow(int addr, int row, byte value) {
-    int offset;
     if(addr<0 || addr>=maxDevices)
 	return;
     if(row<0 || row>7)
 	return;
-    offset=addr*8;
-    status[offset+row]=value;
-    spiTransfer(addr, row+1,status[offset+row]);
+    device(addr).setRow(row,value);
+    updateRow(addr,row);
 }
     
 void LedControl::setColumn(int addr, int col, byte value) {
-    byte val;
-
     if(addr<0 || addr>=maxDevices)
 	return;
     if(col<0 || col>7) 
 	return;
-    for(int row=0;row<8;row++) {
-	val=value >> (7-row);
-	val=val & 0x01;
-	setLed(addr,row,col,val);
-    }
+    //only the rows where the led changes are sent
+    device(addr).setColumn(col,value);
+    updateDevice(addr);
 }
 
 void LedControl::setDigit(int addr, int digit, byte value, boolean dp) {
-    int offset;
     byte v;
 
     if(addr<0 || addr>=maxDevices)
 	return;
     if(digit<0 || digit>7 || value>15)
 	return;
-    offset=addr*8;
-    v=charTable[value];
+    if(control[addr].value[0]&(1<<digit))
+	//Code B has no A..F, 10..15 show as '-','E','H','L','P' and blank
+	v=value;
+    else
+	v=charTable[value];
     if(dp)
 	v|=B10000000;
-    status[offset+digit]=v;
-    spiTransfer(addr, digit+1,v);
+    device(addr).setRow(digit,v);
+    updateRow(addr,digit);
     
 }
 
 void LedControl::setChar(int addr, int digit, char value, boolean dp) {
-    int offset;
-    byte index,v;
-
     if(addr<0 || addr>=maxDevices)
 	return;
     if(digit<0 || digit>7)
  	return;
-    offset=addr*8;
-    index=(byte)value;
-    if(index >127) {
-	//nothing define we use the space char
-	value=32;
+    device(addr).setRow(digit,digitValue(addr,digit,value,dp));
+    updateRow(addr,digit);
+}
+
+byte LedControl::digitValue(int addr, int digit, char c, boolean dp) {
+    byte index,v;
+
+    if(control[addr].value[0]&(1<<digit)) {
+	switch(c) {
+	case '-': v=0x0A; break;
+	case 'E': case 'e': v=0x0B; break;
+	case 'H': case 'h': v=0x0C; break;
+	case 'L': case 'l': v=0x0D; break;
+	case 'P': case 'p': v=0x0E; break;
+	default:
+	    //the digits themselves, everything else is blank
+	    v=(c>='0' && c<='9') ? c-'0' : 0x0F;
+	}
+    }
+    else {
+	index=(byte)c;
+	if(index >127) {
+	    //nothing define we use the space char
+	    index=32;
+	}
+	v=charTable[index];
     }
-    v=charTable[index];
     if(dp)
 	v|=B10000000;
-    status[offset+digit]=v;
-    spiTransfer(addr, digit+1,v);
+    return v;
+}
+
+void LedControl::setDecodeMode(int addr, byte digits) {
+    if(addr<0 || addr>=maxDevices)
+	return;
+    spiTransfer(addr, OP_DECODEMODE, digits);
+}
+
+void LedControl::printNumber(int addr, long value, int first, int count) {
+    printFixed(addr,value,0,first,count);
+}
+
+void LedControl::printFixed(int addr, long value, int decimals, int first, int count) {
+    char figures[8];
+    unsigned long rest;
+    bool negative=value<0;
+    int i=0;
+    LedDevice display;
+
+    if(addr<0 || addr>=maxDevices)
+	return;
+    if(first<0 || count<1 || first+count>8 || decimals<0)
+	return;
+    rest=negative ? 0UL-(unsigned long)value : (unsigned long)value;
+    //figures[0] is the last figure, at least one before the decimal point
+    do {
+	figures[i++]='0'+rest%10;
+	rest/=10;
+    } while((rest>0 || i<=decimals) && i<count);
+    if(negative && i<count)
+	figures[i++]='-';
+    else if(negative)
+	rest=1;
+    if(rest>0 || i<=decimals) {
+	//too long for the digits, or no room for the decimal point
+	i=0;
+	while(i<count)
+	    figures[i++]='-';
+    }
+    while(i<count)
+	figures[i++]=' ';
+    //a digit that shows the same is not marked dirty, and so not sent
+    display=deviceAt(addr);
+    for(i=0;i<count;i++)
+	display.setRow(first+i,digitValue(addr,first+i,figures[i],decimals>0 && i==decimals));
+    updateDevice(addr);
+}
+
+void LedControl::setDeferred(bool enable) {
+    deferredMode=enable;
+    //with a back buffer nothing goes out before present(), in a
+    //transaction nothing before commitTransaction()
+    deferred=enable || frame!=status || transaction;
+    if(!deferred)
+	flush();
+}
+
+bool LedControl::setDoubleBuffer(bool enable, byte *buffer) {
+    if(enable==(frame!=status))
+	return true;
+    if(enable) {
+	if(buffer!=0) 
+	    backBuffer=0;
+	else {
+	    buffer=new byte[maxDevices*8];
+	    if(buffer==0)
+		return false;
+	    backBuffer=buffer;
+	}
+	//a dirty row of the back buffer is one that differs from status[],
+	//rows where status[] is still ahead of the devices go out now
+	flush();
+	//we start drawing on what the devices show right now
+	for(int i=0;i<maxDevices*8;i++)
+	    buffer[i]=status[i];
+	frame=buffer;
+	deferred=true;
+    }
+    else {
+	//the last frame is shown before we draw on status[] again
+	flush();
+	frame=status;
+	if(backBuffer!=0) {
+	    delete[] backBuffer;
+	    backBuffer=0;
+	}
+	deferred=deferredMode || transaction;
+    }
+    return true;
+}
+
+void LedControl::present() {
+    flush();
+}
+
+bool LedControl::isDeferred() {
+    return deferred;
+}
+
+void LedControl::flush() {
+    sendPending();
+}
+
+void LedControl::beginTransaction() {
+    if(transaction)
+	return;
+    transaction=true;
+    deferred=true;
+}
+
+int LedControl::commitTransaction() {
+    if(!transaction)
+	return 0;
+    transaction=false;
+    deferred=deferredMode || frame!=status;
+    return sendPending();
+}
+
+int LedControl::sendPending(bool rows) {
+    int latches=0, i, writes;
+    bool pending;
+    byte *slot;
+
+    for(int addr=0;addr<maxDevices;addr++) {
+	for(int row=0;rows && row<8;row++) {
+	    byte value=frame[addr*8+row];
+	    if(!(dirty[addr]&(1<<row)))
+		continue;
+	    if(frame!=status && value==status[addr*8+row])
+		//a row of the back buffer that ends up the same is not sent
+		dirty[addr]&=~(1<<row);
+	    else
+		//the back buffer becomes what the device shows
+		status[addr*8+row]=value;
+	}
+	if(rows && powerSaving)
+	    updatePower(addr);
+	if(queued!=0) {
+	    //service() sends everything, spidata[] belongs to it now
+	    writes=0;
+	    for(i=0;i<4;i++) {
+		if(control[addr].pending&(1<<i)) {
+		    enqueue(addr,OP_DECODEMODE+i);
+		    writes++;
+		}
+	    }
+	    for(i=0;rows && i<8;i++) {
+		if(dirty[addr]&(1<<i)) {
+		    enqueue(addr,i+1);
+		    writes++;
+		}
+	    }
+	    control[addr].pending=0;
+	    if(rows)
+		dirty[addr]=0;
+	    //the latches service() needs for them
+	    if(writes>latches)
+		latches=writes;
+	}
+    }
+    if(queued!=0)
+	return latches;
+    //every latch takes the next write of every device, devices 
+    //without one left get a no-op
+    do {
+	pending=false;
+	for(int addr=0;addr<maxDevices;addr++) {
+	    slot=spiSlot(addr);
+	    slot[0]=OP_NOOP;
+	    slot[1]=0;
+	    if(control[addr].pending!=0) {
+		for(i=0;!(control[addr].pending&(1<<i));i++)
+		    ;
+		control[addr].pending&=~(1<<i);
+		slot[0]=OP_DECODEMODE+i;
+		slot[1]=control[addr].value[i];
+		pending=true;
+	    }
+	    else if(rows && dirty[addr]!=0) {
+		for(i=0;!(dirty[addr]&(1<<i));i++)
+		    ;
+		dirty[addr]&=~(1<<i);
+		slot[0]=i+1;
+		slot[1]=status[addr*8+i];
+		pending=true;
+	    }
+	}
+	if(pending) {
+	    spiLatch();
+	    latches++;
+	}
+    } while(pending);
+    return latches;
+}
+
+void LedControl::updateRow(int addr, int row) {
+    //LedDevice::setRow() only marks the row when its value changed,
+    //in deferred mode the mark is all that is needed
+    if(deferred || !(dirty[addr]&(1<<row)))
+	return;
+    dirty[addr]&=~(1<<row);
+    spiTransfer(addr, row+1,status[addr*8+row]);
+    if(powerSaving) {
+	updatePower(addr);
+	sendControl(addr);
+    }
+}
+
+void LedControl::updateDevice(int addr) {
+    if(deferred)
+	return;
+    for(int row=0;row<8;row++) {
+	if(dirty[addr]&(1<<row))
+	    spiTransfer(addr, row+1,status[addr*8+row]);
+    }
+    dirty[addr]=0;
+    if(powerSaving) {
+	updatePower(addr);
+	sendControl(addr);
+    }
+}
+
+void LedControl::sendControl(int addr) {
+    for(int i=0;i<4;i++) {
+	if(control[addr].pending&(1<<i)) {
+	    control[addr].pending&=~(1<<i);
+	    spiTransfer(addr,OP_DECODEMODE+i,control[addr].value[i]);
+	}
+    }
 }
 
 void LedControl::spiTransfer(int addr, volatile byte opcode, volatile byte data) {
     //Create an array with the data to shift out
-    int offset=addr*2;
     int maxbytes=maxDevices*2;
-
+    byte *slot=spiSlot(addr);
+
+    LEDCONTROL_STAT(stats.transfers++;)
+    if(opcode>=OP_DECODEMODE && opcode<=OP_SHUTDOWN) {
+	control[addr].value[opcode-OP_DECODEMODE]=data;
+	if(transaction) {
+	    //sent by commitTransaction()
+	    control[addr].pending|=1<<(opcode-OP_DECODEMODE);
+	    return;
+	}
+    }
+    if(queued!=0) {
+	//rows are sent from status[], control registers from control[]
+	if(opcode!=OP_NOOP && opcode<=OP_SHUTDOWN)
+	    enqueue(addr,opcode);
+	return;
+    }
     for(int i=0;i<maxbytes;i++)
 	spidata[i]=(byte)0;
     //put our device data into the array
-    spidata[offset+1]=opcode;
-    spidata[offset]=data;
-    //enable the line 
-    digitalWrite(SPI_CS,LOW);
-    //Now shift out the data 
-    for(int i=maxbytes;i>0;i--)
- 	shiftOut(SPI_MOSI,SPI_CLK,MSBFIRST,spidata[i-1]);
-    //latch the data onto the display
-    digitalWrite(SPI_CS,HIGH);
+    slot[0]=opcode;
+    slot[1]=data;
+    spiLatch();
 }    
 
+int LedControl::scrub(int maxLatches) {
+    int latches=0;
+    byte opcode, data, *slot;
+    bool skip, pending;
+
+    while(latches<maxLatches) {
+	//the rows, then decode mode, intensity, scan limit, shutdown and display test
+	opcode=scrubNext<12 ? scrubNext+1 : OP_DISPLAYTEST;
+	scrubNext=(scrubNext+1)%13;
+	pending=false;
+	for(int addr=0;addr<maxDevices;addr++) {
+	    if(opcode<=OP_DIGIT7) {
+		data=status[addr*8+opcode-1];
+		//a dirty row is ahead of the device, it goes out with the next flush()
+		skip=dirty[addr]&(1<<(opcode-1));
+	    }
+	    else if(opcode<=OP_SHUTDOWN) {
+		data=control[addr].value[opcode-OP_DECODEMODE];
+		skip=control[addr].pending&(1<<(opcode-OP_DECODEMODE));
+	    }
+	    else {
+		data=0;
+		//the display test is never queued
+		skip=queued!=0;
+	    }
+	    if(queued!=0) {
+		if(!skip)
+		    enqueue(addr,opcode);
+		continue;
+	    }
+	    slot=spiSlot(addr);
+	    slot[0]=skip ? OP_NOOP : opcode;
+	    slot[1]=data;
+	    pending=pending || !skip;
+	}
+	if(pending && queued==0)
+	    spiLatch();
+	latches++;
+    }
+    return latches;
+}
+
+void LedControl::spiBroadcast(byte opcode, byte data) {
+    byte *slot;
+
+    if(queued!=0 || transaction) {
+	//service() or commitTransaction() packs the writes of all devices into one latch
+	for(int addr=0;addr<maxDevices;addr++)
+	    spiTransfer(addr,opcode,data);
+	return;
+    }
+    LEDCONTROL_STAT(stats.transfers+=maxDevices;)
+    for(int addr=0;addr<maxDevices;addr++) {
+	if(opcode>=OP_DECODEMODE && opcode<=OP_SHUTDOWN)
+	    control[addr].value[opcode-OP_DECODEMODE]=data;
+	slot=spiSlot(addr);
+	slot[0]=opcode;
+	slot[1]=data;
+    }
+    spiLatch();
+}
+
+bool LedControl::setQueued(bool enable) {
+    byte *flags;
+
+    if(enable==(queued!=0))
+	return true;
+    if(enable) {
+	flags=new byte[maxDevices*13];
+	if(flags==0)
+	    return false;
+	for(int i=0;i<maxDevices*13;i++)
+	    flags[i]=0;
+	//set last, from here on spiTransfer() and flush() only queue
+	queued=flags;
+	return true;
+    }
+    //send what is still waiting
+    while(service(8)>0)
+	;
+    flags=(byte *)queued;
+    queued=0;
+    delete[] flags;
+    return true;
+}
+
+void LedControl::enqueue(int addr, byte opcode) {
+    //the new value must be in memory before service() can see a flag change
+    LEDCONTROL_BARRIER();
+    queued[addr*12+opcode-1]=1;
+    //the register flag goes first, service() looks at it once the device flag is set
+    LEDCONTROL_BARRIER();
+    queued[maxDevices*12+addr]=1;
+}
+
+int LedControl::service(int maxLatches) {
+    int latches=0, addr, i, r;
+    bool pending=true, more;
+    volatile byte *flags, *waiting;
+    byte *slot;
+
+    if(queued==0)
+	return 0;
+    waiting=queued+maxDevices*12;
+    //every latch takes the next write of every device, devices 
+    //without one left get a no-op
+    while(pending && latches<maxLatches) {
+	pending=false;
+	for(addr=0;addr<maxDevices;addr++) {
+	    slot=spiSlot(addr);
+	    slot[0]=OP_NOOP;
+	    slot[1]=0;
+	    if(!waiting[addr])
+		continue;
+	    //cleared before the register flags are read, a write queued
+	    //after this point sets it again
+	    waiting[addr]=0;
+	    LEDCONTROL_BARRIER();
+	    flags=queued+addr*12;
+	    more=false;
+	    //the control registers go first, like in flush()
+	    for(i=0;i<12;i++) {
+		r=(i+8)%12;
+		if(!flags[r])
+		    continue;
+		if(slot[0]!=OP_NOOP) {
+		    more=true;
+		    break;
+		}
+		//the flag is cleared before the value is read, a newer
+		//value written after this point is queued again
+		flags[r]=0;
+		LEDCONTROL_BARRIER();
+		slot[0]=r+1;
+		if(r<8)
+		    slot[1]=status[addr*8+r];
+		else
+		    slot[1]=control[addr].value[r-8];
+		pending=true;
+	    }
+	    if(more)
+		waiting[addr]=1;
+	}
+	if(pending) {
+	    spiLatch();
+	    latches++;
+	}
+    }
+    return latches;
+}
+
+void LedControl::spiLatch() {
+#if LEDCONTROL_STATS
+    unsigned long start=LEDCONTROL_CYCLES();
+
+    stats.latches++;
+    stats.bytes+=maxDevices*2;
+    for(int addr=0;addr<maxDevices;addr++) {
+	if(spiSlot(addr)[0]!=0)
+	    deviceLatches[addr]++;
+    }
+#endif
+    //the first byte in spidata ends up in the last device of the chain
+    transport->transfer(spidata,maxDevices*2);
+    LEDCONTROL_STAT(stats.latch.add(LEDCONTROL_CYCLES()-start);)
+}
+
+#if LEDCONTROL_STATS
+unsigned long LedControl::getDeviceLatches(int addr) {
+    if(addr<0 || addr>=maxDevices)
+	return 0;
+    return deviceLatches[addr];
+}
+
+void LedControl::resetStats() {
+    memset(&stats,0,sizeof(stats));
+    for(int addr=0;addr<maxDevices;addr++)
+	deviceLatches[addr]=0;
+}
+#endif
+
 //a partir daqui, editado por Yuri Crisostomo Bernardo
 void LedControl::printChar(int addr, int pos, char c){
   
-  byte sRow[7], i=0;
-  sRow[0] = 0x00;
-  sRow[6] = 0x00;
+  //a char holds a Latin-1 character, its code point is the same
+  printGlyph(addr, pos, ledFontGlyph((byte)c));
   
-  switch (c){
-    case ' ':
-        sRow[1] = 0x00;
-        sRow[2] = 0x00;
-        sRow[3] = 0x00;
-        sRow[4] = 0x00;
-        sRow[5] = 0x00;
-        break;
-
-    case '!':
-        sRow[1] = 0x00;
-        sRow[2] = 0x00;
-        sRow[3] = 0x2f;
-        sRow[4] = 0x00;
-        sRow[5] = 0x00;
-        break;
-
-    case '"':
-        sRow[1] = 0x00;
-        sRow[2] = 0x07;
-        sRow[3] = 0x00;
-        sRow[4] = 0x07;
-        sRow[5] = 0x00;
-        break;
-
-    case '#':
-        sRow[1] = 0x14;
-        sRow[2] = 0x7f;
-        sRow[3] = 0x14;
-        sRow[4] = 0x7f;
-        sRow[5] = 0x14;
-        break;
-
-    case '$':
-        sRow[1] = 0x24;
-        sRow[2] = 0x2a;
-        sRow[3] = 0x7f;
-        sRow[4] = 0x2a;
-        sRow[5] = 0x12;
-        break;
-
-    case '%':
-        sRow[1] = 0x62;
-        sRow[2] = 0x64;
-        sRow[3] = 0x08;
-        sRow[4] = 0x13;
-        sRow[5] = 0x23;
-        break;
-
-    case '&':
-        sRow[1] = 0x36;
-        sRow[2] = 0x49;
-        sRow[3] = 0x55;
-        sRow[4] = 0x22;
-        sRow[5] = 0x50;
-        break;
-
-    case '(':
-        sRow[1] = 0x00;
-        sRow[2] = 0x1c;
-        sRow[3] = 0x22;
-        sRow[4] = 0x41;
-        sRow[5] = 0x00;
-        break;
-
-    case ')':
-        sRow[1] = 0x00;
-        sRow[2] = 0x41;
-        sRow[3] = 0x22;
-        sRow[4] = 0x1c;
-        sRow[5] = 0x00;
-    break;
-
-    case '*':
-        sRow[1] = 0x14;
-        sRow[2] = 0x08;
-        sRow[3] = 0x3E;
-        sRow[4] = 0x08;
-        sRow[5] = 0x14;
-    break;
-
-    case '+':
-        sRow[1] = 0x08;
-        sRow[2] = 0x08;
-        sRow[3] = 0x3E;
-        sRow[4] = 0x08;
-        sRow[5] = 0x08;
-    break;
-
-    case ',':
-        sRow[1] = 0x00;
-        sRow[2] = 0xA0;
-        sRow[3] = 0x60;
-        sRow[4] = 0x00;
-        sRow[5] = 0x00;
-    break;
-
-    case '-':
-        sRow[1] = 0x08;
-        sRow[2] = 0x08;
-        sRow[3] = 0x08;
-        sRow[4] = 0x08;
-        sRow[5] = 0x08;
-    break;
-
-    case '.':
-        sRow[1] = 0x00;
-        sRow[2] = 0x60;
-        sRow[3] = 0x60;
-        sRow[4] = 0x00;
-        sRow[5] = 0x00;
-    break;
-
-    case '/':
-        sRow[1] = 0x20;
-        sRow[2] = 0x10;
-        sRow[3] = 0x08;
-        sRow[4] = 0x04;
-        sRow[5] = 0x02;
-    break;
-
-    case '0':
-        sRow[1] = 0x3E;
-        sRow[2] = 0x51;
-        sRow[3] = 0x49;
-        sRow[4] = 0x45;
-        sRow[5] = 0x3E;
-    break;
-
-    case '1':
-        sRow[1] = 0x00;
-        sRow[2] = 0x42;
-        sRow[3] = 0x7F;
-        sRow[4] = 0x40;
-        sRow[5] = 0x00;
-    break;
-
-    case '2':
-        sRow[1] = 0x42;
-        sRow[2] = 0x61;
-        sRow[3] = 0x51;
-        sRow[4] = 0x49;
-        sRow[5] = 0x46;
-    break;
-
-    case '3':
-        sRow[1] = 0x21;
-        sRow[2] = 0x41;
-        sRow[3] = 0x45;
-        sRow[4] = 0x4B;
-        sRow[5] = 0x31;
-    break;
-
-    case '4':
-        sRow[1] = 0x18;
-        sRow[2] = 0x14;
-        sRow[3] = 0x12;
-        sRow[4] = 0x7F;
-        sRow[5] = 0x10;
-    break;
-
-    case '5':
-        sRow[1] = 0x27;
-        sRow[2] = 0x45;
-        sRow[3] = 0x45;
-        sRow[4] = 0x45;
-        sRow[5] = 0x39;
-    break;
-
-    case '6':
-        sRow[1] = 0x3C;
-        sRow[2] = 0x4A;
-        sRow[3] = 0x49;
-        sRow[4] = 0x49;
-        sRow[5] = 0x30;
-    break;
-
-    case '7':
-        sRow[1] = 0x01;
-        sRow[2] = 0x71;
-        sRow[3] = 0x09;
-        sRow[4] = 0x05;
-        sRow[5] = 0x03;
-    break;
-
-    case '8':
-        sRow[1] = 0x36;
-        sRow[2] = 0x49;
-        sRow[3] = 0x49;
-        sRow[4] = 0x49;
-        sRow[5] = 0x36;
-    break;
-
-    case '9':
-        sRow[1] = 0x06;
-        sRow[2] = 0x49;
-        sRow[3] = 0x49;
-        sRow[4] = 0x29;
-        sRow[5] = 0x1E;
-    break;
-
-    case ':':
-        sRow[1] = 0x00;
-        sRow[2] = 0x36;
-        sRow[3] = 0x36;
-        sRow[4] = 0x00;
-        sRow[5] = 0x00;
-    break;
-
-    case ';':
-        sRow[1] = 0x00;
-        sRow[2] = 0x56;
-        sRow[3] = 0x36;
-        sRow[4] = 0x00;
-        sRow[5] = 0x00;
-    break;
-
-    case '<':
-        sRow[1] = 0x08;
-        sRow[2] = 0x14;
-        sRow[3] = 0x22;
-        sRow[4] = 0x41;
-        sRow[5] = 0x00;
-    break;
-
-    case '=':
-        sRow[1] = 0x14;
-        sRow[2] = 0x14;
-        sRow[3] = 0x14;
-        sRow[4] = 0x14;
-        sRow[5] = 0x14;
-    break;
-
-    case '>':
-        sRow[1] = 0x00;
-        sRow[2] = 0x41;
-        sRow[3] = 0x22;
-        sRow[4] = 0x14;
-        sRow[5] = 0x08;
-    break;
-
-    case '?':
-        sRow[1] = 0x02;
-        sRow[2] = 0x01;
-        sRow[3] = 0x51;
-        sRow[4] = 0x09;
-        sRow[5] = 0x06;
-    break;
-
-    case '@':
-        sRow[1] = 0x32;
-        sRow[2] = 0x49;
-        sRow[3] = 0x59;
-        sRow[4] = 0x51;
-        sRow[5] = 0x3E;
-    break;
-
-    case 'A':
-        sRow[1] = 0x7C;
-        sRow[2] = 0x12;
-        sRow[3] = 0x11;
-        sRow[4] = 0x12;
-        sRow[5] = 0x7C;
-    break;
-
-    case 'B':
-        sRow[1] = 0x7F;
-        sRow[2] = 0x49;
-        sRow[3] = 0x49;
-        sRow[4] = 0x49;
-        sRow[5] = 0x36;
-    break;
-
-    case 'C':
-        sRow[1] = 0x3E;
-        sRow[2] = 0x41;
-        sRow[3] = 0x41;
-        sRow[4] = 0x41;
-        sRow[5] = 0x22;
-    break;
-
-    case 'D':
-        sRow[1] = 0x7F;
-        sRow[2] = 0x41;
-        sRow[3] = 0x41;
-        sRow[4] = 0x22;
-        sRow[5] = 0x1C;
-    break;
-
-    case 'E':
-        sRow[1] = 0x7F;
-        sRow[2] = 0x49;
-        sRow[3] = 0x49;
-        sRow[4] = 0x49;
-        sRow[5] = 0x41;
-    break;
-
-    case 'F':
-        sRow[1] = 0x7F;
-        sRow[2] = 0x09;
-        sRow[3] = 0x09;
-        sRow[4] = 0x09;
-        sRow[5] = 0x01;
-    break;
-
-    case 'G':
-        sRow[1] = 0x3E;
-        sRow[2] = 0x41;
-        sRow[3] = 0x49;
-        sRow[4] = 0x49;
-        sRow[5] = 0x7A;
-    break;
-
-    case 'H':
-        sRow[1] = 0x7F;
-        sRow[2] = 0x08;
-        sRow[3] = 0x08;
-        sRow[4] = 0x08;
-        sRow[5] = 0x7F;
-    break;
-
-    case 'I':
-        sRow[1] = 0x00;
-        sRow[2] = 0x41;
-        sRow[3] = 0x7F;
-        sRow[4] = 0x41;
-        sRow[5] = 0x00;
-    break;
-
-    case 'J':
-        sRow[1] = 0x20;
-        sRow[2] = 0x40;
-        sRow[3] = 0x41;
-        sRow[4] = 0x3F;
-        sRow[5] = 0x01;
-    break;
-
-    case 'K':
-        sRow[1] = 0x7F;
-        sRow[2] = 0x08;
-        sRow[3] = 0x14;
-        sRow[4] = 0x22;
-        sRow[5] = 0x41;
-    break;
-
-    case 'L':
-        sRow[1] = 0x7F;
-        sRow[2] = 0x40;
-        sRow[3] = 0x40;
-        sRow[4] = 0x40;
-        sRow[5] = 0x40;
-    break;
-
-    case 'M':
-        sRow[1] = 0x7F;
-        sRow[2] = 0x02;
-        sRow[3] = 0x0C;
-        sRow[4] = 0x02;
-        sRow[5] = 0x7F;
-    break;
-
-    case 'N':
-        sRow[1] = 0x7F;
-        sRow[2] = 0x04;
-        sRow[3] = 0x08;
-        sRow[4] = 0x10;
-        sRow[5] = 0x7F;
-    break;
-
-    case 'O':
-        sRow[1] = 0x3E;
-        sRow[2] = 0x41;
-        sRow[3] = 0x41;
-        sRow[4] = 0x41;
-        sRow[5] = 0x3E;
-    break;
-
-    case 'P':
-        sRow[1] = 0x7F;
-        sRow[2] = 0x09;
-        sRow[3] = 0x09;
-        sRow[4] = 0x09;
-        sRow[5] = 0x06;
-    break;
-
-    case 'Q':
-        sRow[1] = 0x3E;
-        sRow[2] = 0x41;
-        sRow[3] = 0x51;
-        sRow[4] = 0x21;
-        sRow[5] = 0x5E;
-    break;
-
-    case 'R':
-        sRow[1] = 0x7F;
-        sRow[2] = 0x09;
-        sRow[3] = 0x19;
-        sRow[4] = 0x29;
-        sRow[5] = 0x46;
-    break;
-
-    case 'S':
-        sRow[1] = 0x46;
-        sRow[2] = 0x49;
-        sRow[3] = 0x49;
-        sRow[4] = 0x49;
-        sRow[5] = 0x31;
-    break;
-
-    case 'T':
-        sRow[1] = 0x01;
-        sRow[2] = 0x01;
-        sRow[3] = 0x7F;
-        sRow[4] = 0x01;
-        sRow[5] = 0x01;
-    break;
-
-    case 'U':
-        sRow[1] = 0x3F;
-        sRow[2] = 0x40;
-        sRow[3] = 0x40;
-        sRow[4] = 0x40;
-        sRow[5] = 0x3F;
-    break;
-
-    case 'V':
-        sRow[1] = 0x1F;
-        sRow[2] = 0x20;
-        sRow[3] = 0x40;
-        sRow[4] = 0x20;
-        sRow[5] = 0x1F;
-    break;
-
-    case 'W':
-        sRow[1] = 0x3F;
-        sRow[2] = 0x40;
-        sRow[3] = 0x38;
-        sRow[4] = 0x40;
-        sRow[5] = 0x3F;
-    break;
-
-    case 'X':
-        sRow[1] = 0x63;
-        sRow[2] = 0x14;
-        sRow[3] = 0x08;
-        sRow[4] = 0x14;
-        sRow[5] = 0x63;
-    break;
-
-    case 'Y':
-        sRow[1] = 0x07;
-        sRow[2] = 0x08;
-        sRow[3] = 0x70;
-        sRow[4] = 0x08;
-        sRow[5] = 0x07;
-    break;
-
-    case 'Z':
-        sRow[1] = 0x61;
-        sRow[2] = 0x51;
-        sRow[3] = 0x49;
-        sRow[4] = 0x45;
-        sRow[5] = 0x43;
-    break;
-
-    case '[':
-        sRow[1] = 0x00;
-        sRow[2] = 0x7F;
-        sRow[3] = 0x41;
-        sRow[4] = 0x41;
-        sRow[5] = 0x00;
-    break;
-
-    case '\\':
-        sRow[1] = 0x55;
-        sRow[2] = 0xAA;
-        sRow[3] = 0x55;
-        sRow[4] = 0xAA;
-        sRow[5] = 0x55;
-    break;
-
-    case ']':
-        sRow[1] = 0x00;
-        sRow[2] = 0x41;
-        sRow[3] = 0x41;
-        sRow[4] = 0x7F;
-        sRow[5] = 0x00;
-    break;
-
-    case '^':
-        sRow[1] = 0x04;
-        sRow[2] = 0x02;
-        sRow[3] = 0x01;
-        sRow[4] = 0x02;
-        sRow[5] = 0x04;
-    break;
-
-    case '_':
-        sRow[1] = 0x40;
-        sRow[2] = 0x40;
-        sRow[3] = 0x40;
-        sRow[4] = 0x40;
-        sRow[5] = 0x40;
-    break;
-
-    case '`':
-        sRow[1] = 0x00;
-        sRow[2] = 0x03;
-        sRow[3] = 0x05;
-        sRow[4] = 0x00;
-        sRow[5] = 0x00;
-    break;
-
-    case 'a':
-        sRow[1] = 0x20;
-        sRow[2] = 0x54;
-        sRow[3] = 0x54;
-        sRow[4] = 0x54;
-        sRow[5] = 0x78;
-    break;
-
-    case 'b':
-        sRow[1] = 0x7F;
-        sRow[2] = 0x48;
-        sRow[3] = 0x44;
-        sRow[4] = 0x44;
-        sRow[5] = 0x38;
-    break;
-
-    case 'c':
-        sRow[1] = 0x38;
-        sRow[2] = 0x44;
-        sRow[3] = 0x44;
-        sRow[4] = 0x44;
-        sRow[5] = 0x20;
-    break;
-
-    case 'd':
-        sRow[1] = 0x38;
-        sRow[2] = 0x44;
-        sRow[3] = 0x44;
-        sRow[4] = 0x48;
-        sRow[5] = 0x7F;
-    break;
-
-    case 'e':
-        sRow[1] = 0x38;
-        sRow[2] = 0x54;
-        sRow[3] = 0x54;
-        sRow[4] = 0x54;
-        sRow[5] = 0x18;
-    break;
-
-    case 'f':
-        sRow[1] = 0x08;
-        sRow[2] = 0x7E;
-        sRow[3] = 0x09;
-        sRow[4] = 0x01;
-        sRow[5] = 0x02;
-    break;
-
-    case 'g':
-        sRow[1] = 0x18;
-        sRow[2] = 0xA4;
-        sRow[3] = 0xA4;
-        sRow[4] = 0xA4;
-        sRow[5] = 0x7C;
-    break;
-
-    case 'h':
-        sRow[1] = 0x7F;
-        sRow[2] = 0x08;
-        sRow[3] = 0x04;
-        sRow[4] = 0x04;
-        sRow[5] = 0x78;
-    break;
-
-    case 'i':
-        sRow[1] = 0x00;
-        sRow[2] = 0x44;
-        sRow[3] = 0x7D;
-        sRow[4] = 0x40;
-        sRow[5] = 0x00;
-    break;
-
-    case 'j':
-        sRow[1] = 0x40;
-        sRow[2] = 0x80;
-        sRow[3] = 0x84;
-        sRow[4] = 0x7D;
-        sRow[5] = 0x00;
-    break;
-
-    case 'k':
-        sRow[1] = 0x7F;
-        sRow[2] = 0x10;
-        sRow[3] = 0x28;
-        sRow[4] = 0x44;
-        sRow[5] = 0x00;
-    break;
-
-    case 'l':
-        sRow[1] = 0x00;
-        sRow[2] = 0x41;
-        sRow[3] = 0x7F;
-        sRow[4] = 0x40;
-        sRow[5] = 0x00;
-    break;
-
-    case 'm':
-        sRow[1] = 0x7C;
-        sRow[2] = 0x04;
-        sRow[3] = 0x18;
-        sRow[4] = 0x04;
-        sRow[5] = 0x78;
-    break;
-
-    case 'n':
-        sRow[1] = 0x7C;
-        sRow[2] = 0x08;
-        sRow[3] = 0x04;
-        sRow[4] = 0x04;
-        sRow[5] = 0x78;
-    break;
-
-    case 'o':
-        sRow[1] = 0x38;
-        sRow[2] = 0x44;
-        sRow[3] = 0x44;
-        sRow[4] = 0x44;
-        sRow[5] = 0x38;
-    break;
-
-    case 'p':
-        sRow[1] = 0xFC;
-        sRow[2] = 0x24;
-        sRow[3] = 0x24;
-        sRow[4] = 0x24;
-        sRow[5] = 0x18;
-    break;
-
-    case 'q':
-        sRow[1] = 0x18;
-        sRow[2] = 0x24;
-        sRow[3] = 0x24;
-        sRow[4] = 0x18;
-        sRow[5] = 0xFC;
-    break;
-
-    case 'r':
-        sRow[1] = 0x7C;
-        sRow[2] = 0x08;
-        sRow[3] = 0x04;
-        sRow[4] = 0x04;
-        sRow[5] = 0x08;
-    break;
-
-    case 's':
-        sRow[1] = 0x48;
-        sRow[2] = 0x54;
-        sRow[3] = 0x54;
-        sRow[4] = 0x54;
-        sRow[5] = 0x20;
-    break;
-
-    case 't':
-        sRow[1] = 0x04;
-        sRow[2] = 0x3F;
-        sRow[3] = 0x44;
-        sRow[4] = 0x40;
-        sRow[5] = 0x20;
-    break;
-
-    case 'u':
-        sRow[1] = 0x3C;
-        sRow[2] = 0x40;
-        sRow[3] = 0x40;
-        sRow[4] = 0x20;
-        sRow[5] = 0x7C;
-    break;
-
-    case 'v':
-        sRow[1] = 0x1C;
-        sRow[2] = 0x20;
-        sRow[3] = 0x40;
-        sRow[4] = 0x20;
-        sRow[5] = 0x1C;
-    break;
-
-    case 'w':
-        sRow[1] = 0x3C;
-        sRow[2] = 0x40;
-        sRow[3] = 0x30;
-        sRow[4] = 0x40;
-        sRow[5] = 0x3C;
-    break;
-
-    case 'x':
-        sRow[1] = 0x44;
-        sRow[2] = 0x28;
-        sRow[3] = 0x10;
-        sRow[4] = 0x28;
-        sRow[5] = 0x44;
-    break;
-
-    case 'y':
-        sRow[1] = 0x1C;
-        sRow[2] = 0xA0;
-        sRow[3] = 0xA0;
-        sRow[4] = 0xA0;
-        sRow[5] = 0x7C;
-    break;
-
-    case 'z':
-        sRow[1] = 0x44;
-        sRow[2] = 0x64;
-        sRow[3] = 0x54;
-        sRow[4] = 0x4C;
-        sRow[5] = 0x44;
-    break;
-
-    case '{':
-        sRow[1] = 0x00;
-        sRow[2] = 0x10;
-        sRow[3] = 0x7C;
-        sRow[4] = 0x82;
-        sRow[5] = 0x00;
-    break;
-
-    case '|':
-        sRow[1] = 0x00;
-        sRow[2] = 0x00;
-        sRow[3] = 0xFF;
-        sRow[4] = 0x00;
-        sRow[5] = 0x00;
-    break;
-
-    case '}':
-        sRow[1] = 0x00;
-        sRow[2] = 0x82;
-        sRow[3] = 0x7C;
-        sRow[4] = 0x10;
-        sRow[5] = 0x00;
-    break;
-
-    case '':
-        sRow[1] = 0x00;
-        sRow[2] = 0x06;
-        sRow[3] = 0x09;
-        sRow[4] = 0x09;
-        sRow[5] = 0x06;
-    break;   
-  }
+}
+
+void LedControl::printGlyph(int addr, int pos, const byte *glyph){
   
-  for (i=0; i<7; i++){
-    LedControl::setRow(addr, pos+i, sRow[i]);
+  int first, last, col;
+  LEDCONTROL_STAT(unsigned long start=LEDCONTROL_CYCLES();)
+
+  //only the columns inside the 8 visible ones are drawn
+  first = pos < 0 ? 0 : pos;
+  last = pos+1+FONT_COLUMNS > 7 ? 7 : pos+1+FONT_COLUMNS;
+  for (col=first; col<=last; col++){
+    if (col == pos || col == pos+1+FONT_COLUMNS){
+      //one blank column on each side of the glyph
+      LedControl::setRow(addr, col, 0x00);
+    }else{
+      LedControl::setRow(addr, col, pgm_read_byte(glyph+col-pos-1));
+    }
   }
+  LEDCONTROL_STAT(stats.printChar.add(LEDCONTROL_CYCLES()-start);)
   
- }
+}
 
-void LedControl::printString(int addr, int pos, char string[]){
+void LedControl::printString(int addr, int pos, const char string[]){
   
-  int i=0;
+  printString(addr, pos, string, -1);
   
-  while (string[i] != '\0'){
-    printChar(addr, 6*i+pos, string[i]);
-    i++;
+}
+
+void LedControl::printString(int addr, int pos, const char string[], int length){
+  
+  int i=0, skip;
+  unsigned int c;
+  byte size;
+  
+  //every character takes 6 columns, so the ones left of column 0 are
+  //stepped over without decoding them, ASCII a byte at a time
+  if (pos < -6){
+    skip = (-pos-1)/6;
+    pos += skip*6;
+    while (skip > 0 && (length < 0 ? string[i] != '\0' : i < length)){
+      if ((byte)string[i] < 0x80){
+        i++;
+      }else{
+        ledUtf8Next(string, length, i, &size);
+        i += size;
+      }
+      skip--;
+    }
+  }
+  
+  //the character at byte i covers the columns pos up to pos+6, stop after the last one that reaches into column 7
+  while (pos <= 7 && (length < 0 ? string[i] != '\0' : i < length)){
+    c = ledUtf8Next(string, length, i, &size);
+    //skip the ones left of column 0
+    if (pos >= -6){
+      printGlyph(addr, pos, ledFontGlyph(c));
+    }
+    pos += 6;
+    i += size;
   }
   
 }
 
 
-void LedControl::printStringScroll(int addr, int pos, char string[], int tDelay, char sentido){
+void LedControl::scrollColumn(int addr, byte value, char sentido){
+  
+  int offset, i;
+  byte next;
+  
+  if (addr<0 || addr>=maxDevices){
+    return;
+  }
+  offset=addr*8;
+  //the columns of the matrix are the rows of the MAX7219
+  if (sentido == '<'){
+    for (i=0; i<8; i++){
+      next = i<7 ? frame[offset+i+1] : value;
+      if (next != frame[offset+i]){
+        frame[offset+i]=next;
+        dirty[addr] |= 1<<i;
+      }
+    }
+  }else{
+    for (i=7; i>=0; i--){
+      next = i>0 ? frame[offset+i-1] : value;
+      if (next != frame[offset+i]){
+        frame[offset+i]=next;
+        dirty[addr] |= 1<<i;
+      }
+    }
+  }
+  if (!deferred){
+    flush();
+  }
+  
+}
+
+void LedControl::printStringScroll(int addr, int pos, const char string[], int tDelay, char sentido){
   
-  int i=0, c=0;
+  int i=0, c=0, frames;
+  LedTextColumns columns;
   
   while (string[c] != '\0'){
     c++;
   }
+  //one frame for every column, characters outside ASCII take more than one byte
+  frames = ledTextWidth(string, c)-1;
   
   if (sentido == '<'){
     
-    for (i=0; i<((c*6)+1); i++){
-      printString(addr, -i+pos, string);
+    printString(addr, pos, string, c);
+    delay(tDelay);
+    //the column that scrolls in at the right edge is column 8 of the first frame
+    columns.start(string, c, 8-pos);
+    for (i=1; i<(frames+1); i++){
+      LEDCONTROL_STAT(unsigned long start=LEDCONTROL_CYCLES();)
+      scrollColumn(addr, columns.next(), sentido);
+      LEDCONTROL_STAT(stats.frame.add(LEDCONTROL_CYCLES()-start);)
       delay(tDelay);
     }
     
   }else if (sentido == '>'){
     
-    for (i=0; i<((c*6)+1); i++){
-      printString(addr, (-(c*6)+i)+pos, string);
+    printString(addr, -frames+pos, string, c);
+    delay(tDelay);
+    //the column that scrolls in at the left edge is column -1 of the first frame
+    columns.start(string, c, frames-1-pos, true);
+    for (i=1; i<(frames+1); i++){
+      LEDCONTROL_STAT(unsigned long start=LEDCONTROL_CYCLES();)
+      scrollColumn(addr, columns.next(), sentido);
+      LEDCONTROL_STAT(stats.frame.add(LEDCONTROL_CYCLES()-start);)
       delay(tDelay);
     }
     
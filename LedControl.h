@@ -33,6 +33,52 @@
 #include <WProgram.h>
 #endif
 
+#include "LedTransport.h"
+#include "LedSprite.h"
+
+/*
+ * Set LEDCONTROL_STATS to 1 (here or with -DLEDCONTROL_STATS=1) to count
+ * the bus traffic and measure how long the transfers, printChar and the
+ * scroll frames take. With 0 the counters are not compiled in at all.
+ */
+#ifndef LEDCONTROL_STATS
+#define LEDCONTROL_STATS 0
+#endif
+
+#if LEDCONTROL_STATS
+/* 
+ * A timestamp in cpu cycles, or in microseconds where we can't count 
+ * cycles. Only the ESP boards count single cycles, elsewhere micros() 
+ * is scaled to cycles: on a 16MHz AVR micros() moves in steps of 4us, 
+ * so the values are multiples of 64 cycles and the lowest buckets of a
+ * LedHistogram stay empty.
+ */
+#if defined(ESP8266) || defined(ESP32)
+#define LEDCONTROL_CYCLES() ESP.getCycleCount()
+#elif defined(F_CPU)
+#define LEDCONTROL_CYCLES() (micros()*(F_CPU/1000000UL))
+#else
+#define LEDCONTROL_CYCLES() micros()
+#endif
+/* Code that only exists when the counters are compiled in */
+#define LEDCONTROL_STAT(code) code
+#else
+#define LEDCONTROL_STAT(code)
+#endif
+
+/*
+ * Keeps memory accesses from moving across this point. The queue and
+ * LedRingSource rely on it for the order in which an interrupt or the 
+ * other side sees their flags and values. A single core only needs the
+ * compiler to keep the order, on the ESP32 service() or the writer may 
+ * run on the other core, so the cpu gets a full memory barrier too.
+ */
+#if defined(ESP32)
+#define LEDCONTROL_BARRIER() __sync_synchronize()
+#else
+#define LEDCONTROL_BARRIER() asm volatile("" ::: "memory")
+#endif
+
 /*
  * Segments to be switched on for characters and digits on
  * 7-Segment Displays
@@ -56,35 +102,290 @@ const static byte charTable[128] = {
     B00000000,B00000000,B00000000,B00000000,B00000000,B00000000,B00000000,B00000000
 };
 
+/*
+ * A handle to the led-status of one device. The address is checked
+ * once when the handle is created, after that every draw call is a
+ * plain write into the led-status of the controler. The rows that 
+ * change are marked dirty and go out with the next LedControl::flush().
+ * The handle follows the controler to its back buffer and back, so it
+ * stays valid across LedControl::setDoubleBuffer(). Row and column 
+ * numbers are taken modulo 8.
+ */
+class LedDevice {
+ private :
+    /* Where the controler draws, status[] or the back buffer */
+    byte *const *frame;
+    /* The offset of the 8 bytes of the device in it */
+    int offset;
+    /* The dirty-row bits of the device */
+    byte *dirty;
+
+    /* The 8 bytes of led-status of the device */
+    byte *rows() const { return *frame+offset; }
+
+ public:
+    /* An invalid handle */
+    LedDevice() : frame(0), offset(0), dirty(0) {}
+    LedDevice(byte *const *frame, int offset, byte *dirty) 
+	: frame(frame), offset(offset), dirty(dirty) {}
+
+    /*
+     * Returns :
+     * bool	false if the handle was created for an address out of range.
+     *		The draw calls must not be used on such a handle.
+     */
+    bool isValid() const { return frame!=0; }
+
+    /* Get the current value of a row */
+    byte getRow(int row) const { return rows()[row&7]; }
+
+    /* Set all 8 Led's in a row, see LedControl::setRow() */
+    void setRow(int row, byte value) {
+	byte *current;
+	row&=7;
+	current=rows()+row;
+	if(*current!=value) {
+	    *current=value;
+	    *dirty|=1<<row;
+	}
+    }
+
+    /* Set the status of a single Led, see LedControl::setLed() */
+    void setLed(int row, int col, bool state) {
+	byte mask=B10000000 >> (col&7);
+	setRow(row,state ? (getRow(row)|mask) : (getRow(row)&~mask));
+    }
+
+    /* Set all 8 Led's in a column, see LedControl::setColumn() */
+    void setColumn(int col, byte value) {
+	byte mask=B10000000 >> (col&7);
+	for(int row=0;row<8;row++)
+	    setRow(row,(value>>(7-row))&0x01 ? (getRow(row)|mask) : (getRow(row)&~mask));
+    }
+
+    /* Switch all Leds off */
+    void clear() {
+	for(int row=0;row<8;row++)
+	    setRow(row,0x00);
+    }
+
+    /* Get all 8 rows as a sprite, row R is byte R */
+    LedSprite getSprite() const {
+	LedSprite sprite=0;
+	for(int row=7;row>=0;row--)
+	    sprite=(sprite<<8)|getRow(row);
+	return sprite;
+    }
+
+    /* Set all 8 rows from a sprite, only rows that change are marked dirty */
+    void setSprite(LedSprite sprite) {
+	for(int row=0;row<8;row++) {
+	    setRow(row,(byte)sprite);
+	    sprite>>=8;
+	}
+    }
+
+    /* Draw a sprite on the device, see ledSpriteBlit() */
+    void blit(LedSprite sprite, int x, int y, byte op=LEDSPRITE_OR) {
+	setSprite(ledSpriteBlit(getSprite(),sprite,x,y,op));
+    }
+};
+
+#if LEDCONTROL_STATS
+/* Number of buckets of a LedHistogram */
+#define LEDHISTOGRAM_BUCKETS 24
+
+/*
+ * A latency histogram. Bucket i counts the samples that took
+ * 2^(i-1) up to 2^i-1 cycles, the last bucket takes everything longer.
+ */
+struct LedHistogram {
+    unsigned int bucket[LEDHISTOGRAM_BUCKETS];
+    unsigned long count;
+    unsigned long total;
+    unsigned long max;
+
+    void add(unsigned long cycles) {
+	byte i=0;
+	for(unsigned long c=cycles;c!=0 && i<LEDHISTOGRAM_BUCKETS-1;c>>=1)
+	    i++;
+	bucket[i]++;
+	count++;
+	total+=cycles;
+	if(cycles>max)
+	    max=cycles;
+    }
+};
+
+/* The counters of a LedControl, see LedControl::getStats() */
+struct LedStats {
+    /* Number of calls of spiTransfer, one command for one device */
+    unsigned long transfers;
+    /* Number of times the chain was latched, by spiTransfer or flush */
+    unsigned long latches;
+    /* 
+     * Number of bytes shifted out for the whole chain, 2 for every 
+     * device and latch. LedControl::getDeviceBytes() has the bytes of a
+     * single device.
+     */
+    unsigned long bytes;
+    /* Cycles for shifting out and latching the chain */
+    LedHistogram latch;
+    /* Cycles for a printChar */
+    LedHistogram printChar;
+    /* Cycles for a scroll frame */
+    LedHistogram frame;
+};
+#endif
+
+/* The control registers of a device, as LedControl last set them */
+struct LedDeviceControl {
+    /* Decode mode, intensity, scan limit and shutdown, in the order of their opcodes */
+    byte value[4];
+    /* Bit N is set while value[N] waits for commitTransaction() */
+    byte pending;
+    /* The values the sketch asked for, the power manager may send others */
+    byte requested[4];
+};
+
 class LedControl {
  private :
-    /* The array for shifting the data to the devices */
-    byte spidata[16];
+    /* The array for shifting the data to the devices, 2 bytes per device */
+    byte *spidata;
     /* Send out a single command to the device */
     void spiTransfer(int addr, byte opcode, byte data);
+    /* Send the same command to every device of the chain in one latch */
+    void spiBroadcast(byte opcode, byte data);
+    /* Shift the prepared spidata array out to the chain and latch it */
+    void spiLatch();
+    /* The opcode/data pair for a device inside the spidata array */
+    byte *spiSlot(int addr) { return spidata+(maxDevices-1-addr)*2; }
+    /* Allocate the arrays for the public constructors */
+    void allocate(int numDevices);
+    /* A copy would share the arrays and the transport, so there are none */
+    LedControl(const LedControl &);
+    LedControl &operator=(const LedControl &);
+    /* Setup the transport and the devices, shared by the constructors */
+    void init();
+    /* Send a row from the status array if it is dirty, unless we are in deferred mode */
+    void updateRow(int addr, int row);
+    /* Send the dirty rows of one device, unless we are in deferred mode */
+    void updateDevice(int addr);
+    /* 
+     * Send the dirty rows and pending control registers, packed into as
+     * few latches as possible. With rows false only the control registers
+     * are sent, the dirty rows wait.
+     */
+    int sendPending(bool rows=true);
+    /* Send the pending control registers of one device, one write each */
+    void sendControl(int addr);
+    /* Note a control register value from the sketch and send it, or what the power manager makes of it */
+    void setControl(int addr, byte opcode, byte data);
+    /* The same for every device of the chain */
+    void setControlAll(byte opcode, byte data);
+    /* Mark a control register pending if the device does not have that value yet */
+    void changeControl(int addr, byte opcode, byte data);
+    /* Work out shutdown, scan limit and intensity of a device from its led-status */
+    void updatePower(int addr);
+    /* The register value that shows a character on a digit, Code B if the digit is decoded */
+    byte digitValue(int addr, int digit, char c, boolean dp);
+    /* Draw a glyph of the font with a blank column on each side, like printChar */
+    void printGlyph(int addr, int pos, const byte *glyph);
+    /* Flag a register write for service(), unless it is already waiting */
+    void enqueue(int addr, byte opcode);
 
-    /* We keep track of the led-status for all 8 devices in this array */
-    byte status[64];
-    /* Data is shifted out of this pin*/
-    int SPI_MOSI;
-    /* The clock is signaled on this pin */
-    int SPI_CLK;
-    /* This one is driven LOW for chip selectzion */
-    int SPI_CS;
+    /* We keep track of the led-status for all devices in this array, 8 bytes per device */
+    byte *status;
+    /* One bit per row for every device, set when status[] is ahead of the device */
+    byte *dirty;
+    /* The control registers of every device */
+    LedDeviceControl *control;
+    /* true if the arrays above were allocated by the constructor */
+    bool ownsBuffers;
+    /* If true draw calls only update status[], the rows go out on flush() */
+    bool deferred;
+    /* Where the draw calls go, status[] itself or the back buffer */
+    byte *frame;
+    /* The back buffer if we allocated it */
+    byte *backBuffer;
+    /* The transport used when the controler is created with pin numbers */
+    LedBitBangTransport pins;
+    /* All data to the devices goes out through this one */
+    LedTransport *transport;
     /* The maximum number of devices we use */
     int maxDevices;
+    /* 
+     * In queued mode 12 flags for every device, set while a row or 
+     * control register waits for service(), followed by one flag for 
+     * every device that is set while any of its registers waits. 0 when
+     * not in queued mode. The value is read from status[] or control[]
+     * when it is sent, so a register waits at most once and the flags
+     * can never overflow. Only the sketch sets a flag and only service()
+     * clears one.
+     */
+    volatile byte *queued;
+    /* The register scrub() rewrites next, 0..7 are the rows, 8..11 the control registers, 12 the display test */
+    byte scrubNext;
+    /* true between beginTransaction() and commitTransaction() */
+    bool transaction;
+    /* The deferred mode set with setDeferred(), double buffering and transactions imply it */
+    bool deferredMode;
+    /* true while the power manager picks the control registers, and its budget in leds, 0 for none */
+    bool powerSaving;
+    int powerBudget;
+#if LEDCONTROL_STATS
+    /* The counters and for every device the number of latches that wrote to it */
+    LedStats stats;
+    unsigned long *deviceLatches;
+#endif
+
+ protected :
+    /* The handle for a device, without checking the address */
+    LedDevice deviceAt(int addr) { return LedDevice(&frame,addr*8,dirty+addr); }
+
+    /* 
+     * Create a controler that works on arrays owned by a derived class, 
+     * this is how LedChain gets its compile-time sized arrays.
+     * Params :
+     * dataPin		pin for the data, used when transport is 0
+     * clockPin		pin for the clock, used when transport is 0
+     * csPin		pin for the chip select, used when transport is 0
+     * transport	the transport to use, 0 to bit-bang on the pins
+     * numDevices	number of devices in the chain
+     * statusBuffer	8 bytes for every device
+     * spiBuffer	2 bytes for every device
+     * dirtyBuffer	1 byte for every device
+     * controlBuffer	one LedDeviceControl for every device
+     */
+    LedControl(int dataPin, int clkPin, int csPin, LedTransport *transport, 
+	       int numDevices, byte *statusBuffer, byte *spiBuffer, byte *dirtyBuffer,
+	       LedDeviceControl *controlBuffer);
     
  public:
     /* 
-     * Create a new controler 
+     * Create a new controler. The arrays for the led-status are
+     * allocated for exactly numDevices devices. Use LedChain for
+     * chains of more than 8 devices.
      * Params :
      * dataPin		pin on the Arduino where data gets shifted out
      * clockPin		pin for the clock
      * csPin		pin for selecting the device 
-     * numDevices	maximum number of devices that can be controled
+     * numDevices	maximum number of devices that can be controled (1..8)
      */
     LedControl(int dataPin, int clkPin, int csPin, int numDevices=1);
 
+    /* 
+     * Create a new controler that sends its data through a transport,
+     * for instance a LedHardwareSpiTransport. The transport must stay
+     * alive as long as the controler is used.
+     * Params :
+     * transport	the transport connected to the devices
+     * numDevices	maximum number of devices that can be controled
+     */
+    LedControl(LedTransport &transport, int numDevices=1);
+
+    ~LedControl();
+
     /*
      * Gets the number of devices attached to this LedControl.
      * Returns :
@@ -92,6 +393,21 @@ class LedControl {
      */
     int getDeviceCount();
 
+    /*
+     * Get a handle for drawing directly into the led-status of a 
+     * device. The address is checked here and never again. 
+     * Changes made through the handle are sent by flush().
+     * Params :
+     * addr	address of the display
+     * Returns :
+     * LedDevice	the handle, invalid if addr is out of range
+     */
+    LedDevice device(int addr) {
+	if(addr<0 || addr>=maxDevices)
+	    return LedDevice();
+	return deviceAt(addr);
+    }
+
     /* 
      * Set the shutdown (power saving) mode for the device
      * Params :
@@ -119,6 +435,29 @@ class LedControl {
      */
     void setIntensity(int addr, int intensity);
 
+    /* 
+     * Set the shutdown mode of every device in the chain with a single
+     * latch, no matter how long the chain is.
+     * Params :
+     * status	If true the devices go into power-down mode. Set to false
+     *		for normal operation.
+     */
+    void shutdownAll(bool status);
+
+    /* 
+     * Set the scan limit of every device in the chain with a single latch
+     * Params :
+     * limit	number of digits to be displayed (1..8)
+     */
+    void setScanLimitAll(int limit);
+
+    /* 
+     * Set the brightness of every device in the chain with a single latch
+     * Params:
+     * intensity	the brightness of the displays. (0..15)
+     */
+    void setIntensityAll(int intensity);
+
     /* 
      * Switch all Leds on the display off. 
      * Params:
@@ -180,13 +519,336 @@ class LedControl {
      * dp	sets the decimal point.
      */
     void setChar(int addr, int digit, char value, boolean dp);
+
+    /*
+     * Let the device decode some digits itself with its Code B font.
+     * A decoded digit takes the number to show instead of the segments:
+     * setDigit and setChar then send 0..9, '-', 'E', 'H', 'L', 'P' and
+     * ' ' as Code B. Other characters show up blank on a decoded digit.
+     * Params:
+     * addr	address of the display
+     * digits	bit N set to decode digit N, 0xFF for all of them
+     */
+    void setDecodeMode(int addr, byte digits);
+
+    /*
+     * Show an integer on a 7-Segment display, right aligned. Only the 
+     * digits that differ from what the display shows are sent, so a 
+     * counter that goes up by one usually costs a single write.
+     * Params:
+     * addr	address of the display
+     * value	the number, negative numbers get a '-'
+     * first	the digit for the last figure of the number, digit 0 is 
+     *		the rightmost one on most modules
+     * count	number of digits used, from first on. If the number does
+     *		not fit all of them show '-'.
+     */
+    void printNumber(int addr, long value, int first=0, int count=8);
+
+    /*
+     * Show a fixed-point number on a 7-Segment display, like printNumber.
+     * Params:
+     * addr	address of the display
+     * value	the number times 10^decimals, 1234 with 2 decimals is 12.34
+     * decimals	number of figures after the decimal point
+     * first	the digit for the last figure of the number
+     * count	number of digits used, from first on. If the number and
+     *		the figure before the decimal point do not fit all of 
+     *		them show '-'.
+     */
+    void printFixed(int addr, long value, int decimals, int first=0, int count=8);
+
+    /*
+     * Switch deferred mode on or off. In deferred mode setLed, setRow,
+     * setColumn, setDigit, setChar and clearDisplay only update the
+     * internal led-status and mark the row as dirty. Nothing is sent 
+     * to the devices until flush() is called. Switching deferred mode 
+     * off flushes all pending rows.
+     * Params:
+     * enable	true to defer the updates, false to send them immediately
+     */
+    void setDeferred(bool enable);
+
+    /*
+     * Returns :
+     * bool	true if the controler is in deferred mode
+     */
+    bool isDeferred();
+
+    /*
+     * Switch double buffering on or off. With a back buffer all draw 
+     * calls change the back buffer only, the devices keep showing the
+     * last frame until present() is called. This implies deferred mode.
+     * Switching it on first sends the rows that are still waiting, 
+     * switching it off shows the back buffer and goes back to the
+     * deferred mode set with setDeferred().
+     * Params:
+     * enable	true to draw on a back buffer
+     * buffer	8 bytes for every device to use as the back buffer,
+     *		if 0 it is allocated
+     * Returns :
+     * bool	false if the back buffer could not be allocated
+     */
+    bool setDoubleBuffer(bool enable, byte *buffer=0);
+
+    /*
+     * Show the back buffer. Each row is compared with what the devices
+     * show and only the rows that differ are sent, packed like flush()
+     * does. Unchanged rows cost nothing.
+     */
+    void present();
+
+    /*
+     * Send all dirty rows to the devices. Every latch carries a dirty 
+     * row for each device that still has one, so a full redraw of the 
+     * chain costs 8 latches no matter how many devices there are. Rows 
+     * that did not change are skipped.
+     */
+    void flush();
+
+    /*
+     * Start collecting writes. Until commitTransaction() the draw calls
+     * work like in deferred mode, and shutdown, setIntensity, 
+     * setScanLimit and their broadcast variants only note the new value.
+     */
+    void beginTransaction();
+
+    /*
+     * Send everything collected since beginTransaction(). Every latch
+     * carries one write for each device that still has one, so writes 
+     * to different devices share a latch whatever register they go to.
+     * Changing the intensity of device 2, row 3 of device 5 and the 
+     * shutdown mode of device 0 takes a single latch.
+     * Returns :
+     * int	the number of latches used, the largest number of writes
+     *		any single device had waiting. In queued mode nothing is 
+     *		sent yet, it is the number of latches service() needs 
+     *		for the writes that were queued.
+     */
+    int commitTransaction();
+
+    /*
+     * Rewrite registers of the devices from the led-status and the 
+     * values last set for the control registers, so a device whose 
+     * registers were corrupted, for instance by electrical noise, 
+     * recovers without a visible redraw. Every latch rewrites the same
+     * register on all devices, the next call goes on with the next one.
+     * 13 latches refresh the whole chain. Rows that are dirty and 
+     * control registers waiting for commitTransaction() are skipped.
+     * Params:
+     * maxLatches	the most latches sent by this call, the bus time 
+     *			spent is maxLatches times the time for one latch
+     * Returns :
+     * int	the number of registers rewritten on every device
+     */
+    int scrub(int maxLatches=1);
+
+    /*
+     * Switch queued mode on or off. In queued mode the calls that 
+     * would send something to the devices only put the register write
+     * into a queue and return, service() sends them later, usually from
+     * a timer interrupt. A register that is written again while it is 
+     * still in the queue is sent once, with the last value. Stop calling
+     * service() before queued mode is switched off, the writes still in
+     * the queue are then sent right away.
+     * Params:
+     * enable	true to queue the writes, false to send them immediately
+     * Returns :
+     * bool	false if the queue could not be allocated
+     */
+    bool setQueued(bool enable);
+
+    /*
+     * Returns :
+     * bool	true if the writes wait in the queue for service()
+     */
+    bool isQueued() { return queued!=0; }
+
+    /*
+     * Send the writes waiting in the queue. Every latch carries one 
+     * write for each device that still has one, so redrawing all rows
+     * of the chain takes 8 latches like flush(). This is the only 
+     * function that may be called from an interrupt, while the sketch
+     * keeps drawing. Only one place may call it.
+     * Params:
+     * maxLatches	the most latches sent by one call, this bounds the
+     *			time spent in the interrupt
+     * Returns :
+     * int	the number of latches sent
+     */
+    int service(int maxLatches);
+
+    /*
+     * Switch the power manager on or off. While it is on, the control
+     * registers are worked out from the led-status every time rows are 
+     * sent: a device with all leds off is shut down, the scan limit 
+     * stops at the last row that has a lit led and the intensity is 
+     * lowered so a device with many lit leds stays within the budget.
+     * A device wakes up again with the first row that has a lit led.
+     * The values set with shutdown(), setScanLimit() and setIntensity()
+     * are the upper limits, a device shut down by the sketch stays off.
+     * The scan limit never goes below 4 rows, the datasheet warns about
+     * the current of the digit drivers with 3 or less, and the intensity
+     * is scaled down with it so the leds look the same as with the full
+     * scan limit. Switching it off sends the values set by the sketch.
+     * Params:
+     * enable	true to let the power manager pick the control registers
+     * budget	the number of leds a device may light at full intensity, 
+     *		a device with more lit leds gets a lower intensity. 0 for
+     *		no limit. Intensity 0 is the lowest the device goes.
+     */
+    void setPowerSaving(bool enable, int budget=0);
+
+    /*
+     * Returns :
+     * bool	true if the power manager is on
+     */
+    bool isPowerSaving() { return powerSaving; }
     
     //a partir daqui, editado por Yuri Crisostomo Bernardo
+    //c is a Latin-1 character, the strings below are UTF-8
     void printChar(int addr, int pos, char c);
     
-    void printStringScroll(int addr, int pos, char string[], int tDelay, char sentido);
+    void printStringScroll(int addr, int pos, const char string[], int tDelay, char sentido);
     
-    void printString(int addr, int pos, char string[]);
+    void printString(int addr, int pos, const char string[]);
+
+    /*
+     * Draw the part of a string that is visible on the display. Only
+     * the characters that reach into the 8 columns are drawn, the ones
+     * before them are stepped over without decoding them and nothing 
+     * is decoded after the last of them.
+     * Params:
+     * addr	address of the display
+     * pos	column where the first character starts, may be negative
+     * string	the text to draw, UTF-8
+     * length	number of bytes in string, -1 if it is unknown
+     */
+    void printString(int addr, int pos, const char string[], int length);
+
+    /*
+     * Move the content of a display by one column and fill in the
+     * column that scrolls in. Only the rows that change are sent.
+     * Params:
+     * addr	address of the display
+     * value	the new column, bit 0 is the top led
+     * sentido	'<' moves everything to the left and value ends up in 
+     *		the rightmost column, '>' moves to the right
+     */
+    void scrollColumn(int addr, byte value, char sentido);
+
+#if LEDCONTROL_STATS
+    /*
+     * Get a copy of the counters.
+     * Returns :
+     * LedStats	the counters since the start or the last resetStats()
+     */
+    LedStats getStats() { return stats; }
+
+    /*
+     * Get the number of latches that carried a command for a device,
+     * the no-ops for the other devices in the chain are not counted.
+     * Params :
+     * addr	address of the display
+     */
+    unsigned long getDeviceLatches(int addr);
+
+    /*
+     * Get the number of bytes that carried a command for a device, 2 
+     * for every latch counted by getDeviceLatches(). The no-ops that 
+     * pass through it on their way to other devices are not counted.
+     * Params :
+     * addr	address of the display
+     */
+    unsigned long getDeviceBytes(int addr) { return getDeviceLatches(addr)*2; }
+
+    /* Set all counters back to 0 */
+    void resetStats();
+
+    /* 
+     * Add a scroll frame to the statistics, used by LedScroll
+     * Params :
+     * cycles	the time it took to draw the frame
+     */
+    void countFrame(unsigned long cycles) { stats.frame.add(cycles); }
+#endif
+};
+
+/*
+ * The arrays of a LedChain. They live in a base class so they exist
+ * before the LedControl constructor starts talking to the devices.
+ */
+template<int N> struct LedChainBuffers {
+    byte statusBuffer[N*8];
+    byte spiBuffer[N*2];
+    byte dirtyBuffer[N];
+    LedDeviceControl controlBuffer[N];
+};
+
+/*
+ * A LedControl for a chain of exactly N devices. All arrays are 
+ * sized at compile time, a single module only pays for one device 
+ * and long chains (16, 32 or more devices) need no extra pins.
+ * Apart from the constructors the API is the one of LedControl.
+ *
+ * The transport can be given as a second template parameter. It is 
+ * then created inside the chain, e.g. with the pins fixed at compile
+ * time:
+ *	LedChain<4, LedPins<D5,D7,D6> > matrix;
+ */
+template<int N, class Transport=void> class LedChain;
+
+/* The transport of a LedChain that owns its transport */
+template<class Transport> struct LedChainTransport {
+    Transport chainTransport;
+};
+
+template<int N> class LedChain<N,void> : private LedChainBuffers<N>, public LedControl {
+ public:
+    /* 
+     * Params :
+     * dataPin		pin on the Arduino where data gets shifted out
+     * clockPin		pin for the clock
+     * csPin		pin for selecting the device 
+     */
+    LedChain(int dataPin, int clkPin, int csPin)
+	: LedControl(dataPin,clkPin,csPin,0,N,
+		     this->statusBuffer,this->spiBuffer,this->dirtyBuffer,
+		     this->controlBuffer) {}
+
+    /* 
+     * Params :
+     * transport	the transport connected to the devices
+     */
+    LedChain(LedTransport &transport)
+	: LedControl(-1,-1,-1,&transport,N,
+		     this->statusBuffer,this->spiBuffer,this->dirtyBuffer,
+		     this->controlBuffer) {}
+
+    using LedControl::device;
+
+    /* A handle for a device, the address is checked at compile time */
+    template<int ADDR> LedDevice device() {
+	static_assert(ADDR>=0 && ADDR<N,"device address out of range");
+	return this->deviceAt(ADDR);
+    }
+};
+
+template<int N, class Transport> class LedChain 
+    : private LedChainTransport<Transport>, private LedChainBuffers<N>, public LedControl {
+ public:
+    LedChain()
+	: LedControl(-1,-1,-1,&this->chainTransport,N,
+		     this->statusBuffer,this->spiBuffer,this->dirtyBuffer,
+		     this->controlBuffer) {}
+
+    using LedControl::device;
+
+    /* A handle for a device, the address is checked at compile time */
+    template<int ADDR> LedDevice device() {
+	static_assert(ADDR>=0 && ADDR<N,"device address out of range");
+	return this->deviceAt(ADDR);
+    }
 };
 
 #endif	//LedControl.h
@@ -0,0 +1,705 @@
+/*
+ *    LedFont.cpp - The 5x8 font used by LedControl::printChar
+ *
+ *    Released under the same terms as LedControl.h
+ */
+
+#include "LedFont.h"
+
+const byte ledFont[][FONT_COLUMNS] PROGMEM = {
+    { 0x00,0x00,0x00,0x00,0x00 },  // 0x20 space
+    { 0x00,0x00,0x2F,0x00,0x00 },  // 0x21 !
+    { 0x00,0x07,0x00,0x07,0x00 },  // 0x22 "
+    { 0x14,0x7F,0x14,0x7F,0x14 },  // 0x23 #
+    { 0x24,0x2A,0x7F,0x2A,0x12 },  // 0x24 $
+    { 0x62,0x64,0x08,0x13,0x23 },  // 0x25 %
+    { 0x36,0x49,0x55,0x22,0x50 },  // 0x26 &
+    { 0x00,0x00,0x07,0x00,0x00 },  // 0x27 '
+    { 0x00,0x1C,0x22,0x41,0x00 },  // 0x28 (
+    { 0x00,0x41,0x22,0x1C,0x00 },  // 0x29 )
+    { 0x14,0x08,0x3E,0x08,0x14 },  // 0x2A *
+    { 0x08,0x08,0x3E,0x08,0x08 },  // 0x2B +
+    { 0x00,0xA0,0x60,0x00,0x00 },  // 0x2C ,
+    { 0x08,0x08,0x08,0x08,0x08 },  // 0x2D -
+    { 0x00,0x60,0x60,0x00,0x00 },  // 0x2E .
+    { 0x20,0x10,0x08,0x04,0x02 },  // 0x2F /
+    { 0x3E,0x51,0x49,0x45,0x3E },  // 0x30 0
+    { 0x00,0x42,0x7F,0x40,0x00 },  // 0x31 1
+    { 0x42,0x61,0x51,0x49,0x46 },  // 0x32 2
+    { 0x21,0x41,0x45,0x4B,0x31 },  // 0x33 3
+    { 0x18,0x14,0x12,0x7F,0x10 },  // 0x34 4
+    { 0x27,0x45,0x45,0x45,0x39 },  // 0x35 5
+    { 0x3C,0x4A,0x49,0x49,0x30 },  // 0x36 6
+    { 0x01,0x71,0x09,0x05,0x03 },  // 0x37 7
+    { 0x36,0x49,0x49,0x49,0x36 },  // 0x38 8
+    { 0x06,0x49,0x49,0x29,0x1E },  // 0x39 9
+    { 0x00,0x36,0x36,0x00,0x00 },  // 0x3A :
+    { 0x00,0x56,0x36,0x00,0x00 },  // 0x3B ;
+    { 0x08,0x14,0x22,0x41,0x00 },  // 0x3C <
+    { 0x14,0x14,0x14,0x14,0x14 },  // 0x3D =
+    { 0x00,0x41,0x22,0x14,0x08 },  // 0x3E >
+    { 0x02,0x01,0x51,0x09,0x06 },  // 0x3F ?
+    { 0x32,0x49,0x59,0x51,0x3E },  // 0x40 @
+    { 0x7C,0x12,0x11,0x12,0x7C },  // 0x41 A
+    { 0x7F,0x49,0x49,0x49,0x36 },  // 0x42 B
+    { 0x3E,0x41,0x41,0x41,0x22 },  // 0x43 C
+    { 0x7F,0x41,0x41,0x22,0x1C },  // 0x44 D
+    { 0x7F,0x49,0x49,0x49,0x41 },  // 0x45 E
+    { 0x7F,0x09,0x09,0x09,0x01 },  // 0x46 F
+    { 0x3E,0x41,0x49,0x49,0x7A },  // 0x47 G
+    { 0x7F,0x08,0x08,0x08,0x7F },  // 0x48 H
+    { 0x00,0x41,0x7F,0x41,0x00 },  // 0x49 I
+    { 0x20,0x40,0x41,0x3F,0x01 },  // 0x4A J
+    { 0x7F,0x08,0x14,0x22,0x41 },  // 0x4B K
+    { 0x7F,0x40,0x40,0x40,0x40 },  // 0x4C L
+    { 0x7F,0x02,0x0C,0x02,0x7F },  // 0x4D M
+    { 0x7F,0x04,0x08,0x10,0x7F },  // 0x4E N
+    { 0x3E,0x41,0x41,0x41,0x3E },  // 0x4F O
+    { 0x7F,0x09,0x09,0x09,0x06 },  // 0x50 P
+    { 0x3E,0x41,0x51,0x21,0x5E },  // 0x51 Q
+    { 0x7F,0x09,0x19,0x29,0x46 },  // 0x52 R
+    { 0x46,0x49,0x49,0x49,0x31 },  // 0x53 S
+    { 0x01,0x01,0x7F,0x01,0x01 },  // 0x54 T
+    { 0x3F,0x40,0x40,0x40,0x3F },  // 0x55 U
+    { 0x1F,0x20,0x40,0x20,0x1F },  // 0x56 V
+    { 0x3F,0x40,0x38,0x40,0x3F },  // 0x57 W
+    { 0x63,0x14,0x08,0x14,0x63 },  // 0x58 X
+    { 0x07,0x08,0x70,0x08,0x07 },  // 0x59 Y
+    { 0x61,0x51,0x49,0x45,0x43 },  // 0x5A Z
+    { 0x00,0x7F,0x41,0x41,0x00 },  // 0x5B [
+    { 0x55,0xAA,0x55,0xAA,0x55 },  // 0x5C backslash
+    { 0x00,0x41,0x41,0x7F,0x00 },  // 0x5D ]
+    { 0x04,0x02,0x01,0x02,0x04 },  // 0x5E ^
+    { 0x40,0x40,0x40,0x40,0x40 },  // 0x5F _
+    { 0x00,0x03,0x05,0x00,0x00 },  // 0x60 `
+    { 0x20,0x54,0x54,0x54,0x78 },  // 0x61 a
+    { 0x7F,0x48,0x44,0x44,0x38 },  // 0x62 b
+    { 0x38,0x44,0x44,0x44,0x20 },  // 0x63 c
+    { 0x38,0x44,0x44,0x48,0x7F },  // 0x64 d
+    { 0x38,0x54,0x54,0x54,0x18 },  // 0x65 e
+    { 0x08,0x7E,0x09,0x01,0x02 },  // 0x66 f
+    { 0x18,0xA4,0xA4,0xA4,0x7C },  // 0x67 g
+    { 0x7F,0x08,0x04,0x04,0x78 },  // 0x68 h
+    { 0x00,0x44,0x7D,0x40,0x00 },  // 0x69 i
+    { 0x40,0x80,0x84,0x7D,0x00 },  // 0x6A j
+    { 0x7F,0x10,0x28,0x44,0x00 },  // 0x6B k
+    { 0x00,0x41,0x7F,0x40,0x00 },  // 0x6C l
+    { 0x7C,0x04,0x18,0x04,0x78 },  // 0x6D m
+    { 0x7C,0x08,0x04,0x04,0x78 },  // 0x6E n
+    { 0x38,0x44,0x44,0x44,0x38 },  // 0x6F o
+    { 0xFC,0x24,0x24,0x24,0x18 },  // 0x70 p
+    { 0x18,0x24,0x24,0x18,0xFC },  // 0x71 q
+    { 0x7C,0x08,0x04,0x04,0x08 },  // 0x72 r
+    { 0x48,0x54,0x54,0x54,0x20 },  // 0x73 s
+    { 0x04,0x3F,0x44,0x40,0x20 },  // 0x74 t
+    { 0x3C,0x40,0x40,0x20,0x7C },  // 0x75 u
+    { 0x1C,0x20,0x40,0x20,0x1C },  // 0x76 v
+    { 0x3C,0x40,0x30,0x40,0x3C },  // 0x77 w
+    { 0x44,0x28,0x10,0x28,0x44 },  // 0x78 x
+    { 0x1C,0xA0,0xA0,0xA0,0x7C },  // 0x79 y
+    { 0x44,0x64,0x54,0x4C,0x44 },  // 0x7A z
+    { 0x00,0x10,0x7C,0x82,0x00 },  // 0x7B {
+    { 0x00,0x00,0xFF,0x00,0x00 },  // 0x7C |
+    { 0x00,0x82,0x7C,0x10,0x00 },  // 0x7D }
+    { 0x08,0x04,0x08,0x10,0x08 },  // 0x7E ~
+    { 0x7F,0x41,0x41,0x41,0x7F },  // 0x7F fallback
+    { 0x00,0x00,0x00,0x00,0x00 },  // U+00A0 no-break space
+    { 0x00,0x00,0xF4,0x00,0x00 },  // U+00A1 inverted exclamation mark
+    { 0x38,0x44,0xFE,0x44,0x28 },  // U+00A2 cent sign
+    { 0x48,0x7E,0x49,0x43,0x66 },  // U+00A3 pound sign
+    { 0x22,0x1C,0x14,0x1C,0x22 },  // U+00A4 currency sign
+    { 0x2B,0x2F,0x7C,0x2F,0x2B },  // U+00A5 yen sign
+    { 0x00,0x00,0x77,0x00,0x00 },  // U+00A6 broken bar
+    { 0x4A,0x55,0x55,0x55,0x29 },  // U+00A7 section sign
+    { 0x00,0x01,0x00,0x01,0x00 },  // U+00A8 diaeresis
+    { 0x3E,0x41,0x5D,0x55,0x3E },  // U+00A9 copyright sign
+    { 0x26,0x29,0x29,0x2F,0x28 },  // U+00AA feminine ordinal indicator
+    { 0x08,0x14,0x2A,0x14,0x22 },  // U+00AB left-pointing double angle quotation mark
+    { 0x08,0x08,0x08,0x08,0x38 },  // U+00AC not sign
+    { 0x08,0x08,0x08,0x08,0x08 },  // U+00AD soft hyphen
+    { 0x3E,0x5D,0x4D,0x55,0x3E },  // U+00AE registered sign
+    { 0x00,0x01,0x01,0x01,0x00 },  // U+00AF macron
+    { 0x00,0x06,0x09,0x09,0x06 },  // U+00B0 degree sign
+    { 0x44,0x44,0x5F,0x44,0x44 },  // U+00B1 plus-minus sign
+    { 0x00,0x09,0x0D,0x0A,0x00 },  // U+00B2 superscript two
+    { 0x00,0x11,0x15,0x1F,0x00 },  // U+00B3 superscript three
+    { 0x00,0x00,0x02,0x01,0x00 },  // U+00B4 acute accent
+    { 0xFC,0x40,0x40,0x20,0x7C },  // U+00B5 micro sign
+    { 0x06,0x0F,0x7F,0x01,0x7F },  // U+00B6 pilcrow sign
+    { 0x00,0x00,0x08,0x00,0x00 },  // U+00B7 middle dot
+    { 0x00,0x00,0x80,0x80,0x00 },  // U+00B8 cedilla
+    { 0x00,0x12,0x1F,0x10,0x00 },  // U+00B9 superscript one
+    { 0x26,0x29,0x29,0x29,0x26 },  // U+00BA masculine ordinal indicator
+    { 0x22,0x14,0x2A,0x14,0x08 },  // U+00BB right-pointing double angle quotation mark
+    { 0x2F,0x10,0x28,0x34,0xFA },  // U+00BC vulgar fraction one quarter
+    { 0x2F,0x10,0xC8,0xAC,0xBA },  // U+00BD vulgar fraction one half
+    { 0x35,0x1F,0x28,0x34,0xFA },  // U+00BE vulgar fraction three quarters
+    { 0x40,0x80,0x8A,0x90,0x60 },  // U+00BF inverted question mark
+    { 0xF8,0x25,0x23,0x24,0xF8 },  // U+00C0 latin capital letter a with grave
+    { 0xF8,0x24,0x23,0x25,0xF8 },  // U+00C1 latin capital letter a with acute
+    { 0xF8,0x25,0x23,0x25,0xF8 },  // U+00C2 latin capital letter a with circumflex
+    { 0xF8,0x25,0x23,0x25,0xF9 },  // U+00C3 latin capital letter a with tilde
+    { 0xF8,0x25,0x22,0x25,0xF8 },  // U+00C4 latin capital letter a with diaeresis
+    { 0xF8,0x24,0x23,0x24,0xF8 },  // U+00C5 latin capital letter a with ring above
+    { 0x7E,0x09,0x7F,0x49,0x41 },  // U+00C6 latin capital letter ae
+    { 0x3E,0x41,0xC1,0xC1,0x22 },  // U+00C7 latin capital letter c with cedilla
+    { 0xFE,0x93,0x93,0x92,0x82 },  // U+00C8 latin capital letter e with grave
+    { 0xFE,0x92,0x93,0x93,0x82 },  // U+00C9 latin capital letter e with acute
+    { 0xFE,0x93,0x93,0x93,0x82 },  // U+00CA latin capital letter e with circumflex
+    { 0xFE,0x93,0x92,0x93,0x82 },  // U+00CB latin capital letter e with diaeresis
+    { 0x00,0x83,0xFF,0x82,0x00 },  // U+00CC latin capital letter i with grave
+    { 0x00,0x82,0xFF,0x83,0x00 },  // U+00CD latin capital letter i with acute
+    { 0x00,0x83,0xFF,0x83,0x00 },  // U+00CE latin capital letter i with circumflex
+    { 0x00,0x83,0xFE,0x83,0x00 },  // U+00CF latin capital letter i with diaeresis
+    { 0x7F,0x49,0x41,0x22,0x1C },  // U+00D0 latin capital letter eth
+    { 0xFE,0x09,0x11,0x21,0xFF },  // U+00D1 latin capital letter n with tilde
+    { 0x7C,0x83,0x83,0x82,0x7C },  // U+00D2 latin capital letter o with grave
+    { 0x7C,0x82,0x83,0x83,0x7C },  // U+00D3 latin capital letter o with acute
+    { 0x7C,0x83,0x83,0x83,0x7C },  // U+00D4 latin capital letter o with circumflex
+    { 0x7C,0x83,0x83,0x83,0x7D },  // U+00D5 latin capital letter o with tilde
+    { 0x7C,0x83,0x82,0x83,0x7C },  // U+00D6 latin capital letter o with diaeresis
+    { 0x22,0x14,0x08,0x14,0x22 },  // U+00D7 multiplication sign
+    { 0x3E,0x51,0x49,0x45,0x3E },  // U+00D8 latin capital letter o with stroke
+    { 0x7E,0x81,0x81,0x80,0x7E },  // U+00D9 latin capital letter u with grave
+    { 0x7E,0x80,0x81,0x81,0x7E },  // U+00DA latin capital letter u with acute
+    { 0x7E,0x81,0x81,0x81,0x7E },  // U+00DB latin capital letter u with circumflex
+    { 0x7E,0x81,0x80,0x81,0x7E },  // U+00DC latin capital letter u with diaeresis
+    { 0x0E,0x10,0xE1,0x11,0x0E },  // U+00DD latin capital letter y with acute
+    { 0x7F,0x14,0x14,0x14,0x08 },  // U+00DE latin capital letter thorn
+    { 0x7E,0x01,0x4D,0x52,0x20 },  // U+00DF latin small letter sharp s
+    { 0x20,0x55,0x56,0x54,0x78 },  // U+00E0 latin small letter a with grave
+    { 0x20,0x54,0x56,0x55,0x78 },  // U+00E1 latin small letter a with acute
+    { 0x20,0x56,0x55,0x56,0x78 },  // U+00E2 latin small letter a with circumflex
+    { 0x20,0x56,0x55,0x56,0x79 },  // U+00E3 latin small letter a with tilde
+    { 0x20,0x56,0x54,0x56,0x78 },  // U+00E4 latin small letter a with diaeresis
+    { 0x20,0x54,0x57,0x57,0x78 },  // U+00E5 latin small letter a with ring above
+    { 0x24,0x54,0x78,0x54,0x58 },  // U+00E6 latin small letter ae
+    { 0x38,0x44,0xC4,0xC4,0x20 },  // U+00E7 latin small letter c with cedilla
+    { 0x38,0x55,0x56,0x54,0x18 },  // U+00E8 latin small letter e with grave
+    { 0x38,0x54,0x56,0x55,0x18 },  // U+00E9 latin small letter e with acute
+    { 0x38,0x56,0x55,0x56,0x18 },  // U+00EA latin small letter e with circumflex
+    { 0x38,0x56,0x54,0x56,0x18 },  // U+00EB latin small letter e with diaeresis
+    { 0x00,0x45,0x7E,0x40,0x00 },  // U+00EC latin small letter i with grave
+    { 0x00,0x44,0x7E,0x41,0x00 },  // U+00ED latin small letter i with acute
+    { 0x00,0x46,0x7D,0x42,0x00 },  // U+00EE latin small letter i with circumflex
+    { 0x00,0x46,0x7C,0x42,0x00 },  // U+00EF latin small letter i with diaeresis
+    { 0x30,0x48,0x4A,0x4E,0x3D },  // U+00F0 latin small letter eth
+    { 0x7C,0x0A,0x05,0x06,0x79 },  // U+00F1 latin small letter n with tilde
+    { 0x38,0x45,0x46,0x44,0x38 },  // U+00F2 latin small letter o with grave
+    { 0x38,0x44,0x46,0x45,0x38 },  // U+00F3 latin small letter o with acute
+    { 0x38,0x46,0x45,0x46,0x38 },  // U+00F4 latin small letter o with circumflex
+    { 0x38,0x46,0x45,0x46,0x39 },  // U+00F5 latin small letter o with tilde
+    { 0x38,0x46,0x44,0x46,0x38 },  // U+00F6 latin small letter o with diaeresis
+    { 0x08,0x08,0x2A,0x08,0x08 },  // U+00F7 division sign
+    { 0x38,0x64,0x54,0x4C,0x38 },  // U+00F8 latin small letter o with stroke
+    { 0x3C,0x41,0x42,0x20,0x7C },  // U+00F9 latin small letter u with grave
+    { 0x3C,0x40,0x42,0x21,0x7C },  // U+00FA latin small letter u with acute
+    { 0x3C,0x42,0x41,0x22,0x7C },  // U+00FB latin small letter u with circumflex
+    { 0x3C,0x42,0x40,0x22,0x7C },  // U+00FC latin small letter u with diaeresis
+    { 0x1C,0xA0,0xA2,0xA1,0x7C },  // U+00FD latin small letter y with acute
+    { 0xFF,0x24,0x24,0x24,0x18 },  // U+00FE latin small letter thorn
+    { 0x1C,0xA2,0xA0,0xA2,0x7C },  // U+00FF latin small letter y with diaeresis
+    { 0xF9,0x25,0x23,0x25,0xF9 },  // U+0100 latin capital letter a with macron
+    { 0x20,0x56,0x56,0x56,0x78 },  // U+0101 latin small letter a with macron
+    { 0xF9,0x24,0x22,0x24,0xF9 },  // U+0102 latin capital letter a with breve
+    { 0x20,0x55,0x56,0x55,0x78 },  // U+0103 latin small letter a with breve
+    { 0x7C,0x12,0x11,0x92,0xFC },  // U+0104 latin capital letter a with ogonek
+    { 0x20,0x54,0x54,0xD4,0xF8 },  // U+0105 latin small letter a with ogonek
+    { 0x7C,0x82,0x83,0x83,0x44 },  // U+0106 latin capital letter c with acute
+    { 0x38,0x44,0x46,0x45,0x20 },  // U+0107 latin small letter c with acute
+    { 0x7C,0x83,0x83,0x83,0x44 },  // U+0108 latin capital letter c with circumflex
+    { 0x38,0x46,0x45,0x46,0x20 },  // U+0109 latin small letter c with circumflex
+    { 0x7C,0x82,0x83,0x82,0x44 },  // U+010A latin capital letter c with dot above
+    { 0x38,0x44,0x46,0x44,0x20 },  // U+010B latin small letter c with dot above
+    { 0x7D,0x82,0x83,0x82,0x45 },  // U+010C latin capital letter c with caron
+    { 0x38,0x45,0x46,0x45,0x20 },  // U+010D latin small letter c with caron
+    { 0xFF,0x82,0x83,0x44,0x39 },  // U+010E latin capital letter d with caron
+    { 0x38,0x44,0x44,0x48,0x7F },  // U+010F latin small letter d with caron
+    { 0x7F,0x49,0x41,0x22,0x1C },  // U+0110 latin capital letter d with stroke
+    { 0x38,0x44,0x44,0x4A,0x7F },  // U+0111 latin small letter d with stroke
+    { 0xFF,0x93,0x93,0x93,0x83 },  // U+0112 latin capital letter e with macron
+    { 0x38,0x56,0x56,0x56,0x18 },  // U+0113 latin small letter e with macron
+    { 0xFF,0x92,0x92,0x92,0x83 },  // U+0114 latin capital letter e with breve
+    { 0x38,0x55,0x56,0x55,0x18 },  // U+0115 latin small letter e with breve
+    { 0xFE,0x92,0x93,0x92,0x82 },  // U+0116 latin capital letter e with dot above
+    { 0x38,0x54,0x56,0x54,0x18 },  // U+0117 latin small letter e with dot above
+    { 0x7F,0x49,0x49,0xC9,0xC1 },  // U+0118 latin capital letter e with ogonek
+    { 0x38,0x54,0x54,0xD4,0x98 },  // U+0119 latin small letter e with ogonek
+    { 0xFF,0x92,0x93,0x92,0x83 },  // U+011A latin capital letter e with caron
+    { 0x38,0x55,0x56,0x55,0x18 },  // U+011B latin small letter e with caron
+    { 0x7C,0x83,0x93,0x93,0xF4 },  // U+011C latin capital letter g with circumflex
+    { 0x18,0xA6,0xA5,0xA6,0x7C },  // U+011D latin small letter g with circumflex
+    { 0x7D,0x82,0x92,0x92,0xF5 },  // U+011E latin capital letter g with breve
+    { 0x18,0xA5,0xA6,0xA5,0x7C },  // U+011F latin small letter g with breve
+    { 0x7C,0x82,0x93,0x92,0xF4 },  // U+0120 latin capital letter g with dot above
+    { 0x18,0xA4,0xA6,0xA4,0x7C },  // U+0121 latin small letter g with dot above
+    { 0x3E,0x41,0xC9,0xC9,0x7A },  // U+0122 latin capital letter g with cedilla
+    { 0x18,0xA4,0xA6,0xA5,0x7C },  // U+0123 latin small letter g with cedilla
+    { 0xFE,0x11,0x11,0x11,0xFE },  // U+0124 latin capital letter h with circumflex
+    { 0x7F,0x0A,0x05,0x06,0x78 },  // U+0125 latin small letter h with circumflex
+    { 0x7F,0x0A,0x0A,0x0A,0x7F },  // U+0126 latin capital letter h with stroke
+    { 0x7F,0x0A,0x06,0x04,0x78 },  // U+0127 latin small letter h with stroke
+    { 0x00,0x83,0xFF,0x83,0x01 },  // U+0128 latin capital letter i with tilde
+    { 0x00,0x46,0x7D,0x42,0x01 },  // U+0129 latin small letter i with tilde
+    { 0x01,0x83,0xFF,0x83,0x01 },  // U+012A latin capital letter i with macron
+    { 0x00,0x46,0x7E,0x42,0x00 },  // U+012B latin small letter i with macron
+    { 0x01,0x82,0xFE,0x82,0x01 },  // U+012C latin capital letter i with breve
+    { 0x00,0x45,0x7E,0x41,0x00 },  // U+012D latin small letter i with breve
+    { 0x00,0x41,0x7F,0xC1,0x80 },  // U+012E latin capital letter i with ogonek
+    { 0x00,0x44,0x7D,0xC0,0x80 },  // U+012F latin small letter i with ogonek
+    { 0x00,0x82,0xFF,0x82,0x00 },  // U+0130 latin capital letter i with dot above
+    { 0x00,0x44,0x7C,0x40,0x00 },  // U+0131 latin small letter dotless i
+    { 0x7F,0x00,0x20,0x40,0x3F },  // U+0132 latin capital ligature ij
+    { 0x7D,0x00,0x40,0x80,0x7D },  // U+0133 latin small ligature ij
+    { 0x40,0x81,0x83,0x7F,0x02 },  // U+0134 latin capital letter j with circumflex
+    { 0x40,0x82,0x85,0x7E,0x00 },  // U+0135 latin small letter j with circumflex
+    { 0x7F,0x08,0x94,0xA2,0x41 },  // U+0136 latin capital letter k with cedilla
+    { 0x7F,0x10,0xA8,0xC4,0x00 },  // U+0137 latin small letter k with cedilla
+    { 0x7C,0x10,0x28,0x44,0x00 },  // U+0138 latin small letter kra
+    { 0xFE,0x80,0x81,0x81,0x80 },  // U+0139 latin capital letter l with acute
+    { 0x00,0x41,0x7F,0x41,0x00 },  // U+013A latin small letter l with acute
+    { 0x7F,0x40,0xC0,0xC0,0x40 },  // U+013B latin capital letter l with cedilla
+    { 0x00,0x41,0xFF,0xC0,0x00 },  // U+013C latin small letter l with cedilla
+    { 0xFF,0x80,0x81,0x80,0x81 },  // U+013D latin capital letter l with caron
+    { 0x00,0x41,0x7F,0x40,0x03 },  // U+013E latin small letter l with caron
+    { 0x7F,0x40,0x40,0x48,0x40 },  // U+013F latin capital letter l with middle dot
+    { 0x00,0x41,0x7F,0x40,0x08 },  // U+0140 latin small letter l with middle dot
+    { 0x08,0x7F,0x44,0x40,0x40 },  // U+0141 latin capital letter l with stroke
+    { 0x00,0x49,0x7F,0x44,0x00 },  // U+0142 latin small letter l with stroke
+    { 0xFE,0x08,0x11,0x21,0xFE },  // U+0143 latin capital letter n with acute
+    { 0x7C,0x08,0x06,0x05,0x78 },  // U+0144 latin small letter n with acute
+    { 0x7F,0x04,0x88,0x90,0x7F },  // U+0145 latin capital letter n with cedilla
+    { 0x7C,0x08,0x84,0x84,0x78 },  // U+0146 latin small letter n with cedilla
+    { 0xFF,0x08,0x11,0x20,0xFF },  // U+0147 latin capital letter n with caron
+    { 0x7C,0x09,0x06,0x05,0x78 },  // U+0148 latin small letter n with caron
+    { 0x03,0x7C,0x08,0x04,0x78 },  // U+0149 latin small letter n preceded by apostrophe
+    { 0x7F,0x02,0x01,0x81,0x7E },  // U+014A latin capital letter eng
+    { 0x7C,0x08,0x04,0x84,0x78 },  // U+014B latin small letter eng
+    { 0x7D,0x83,0x83,0x83,0x7D },  // U+014C latin capital letter o with macron
+    { 0x38,0x46,0x46,0x46,0x38 },  // U+014D latin small letter o with macron
+    { 0x7D,0x82,0x82,0x82,0x7D },  // U+014E latin capital letter o with breve
+    { 0x38,0x45,0x46,0x45,0x38 },  // U+014F latin small letter o with breve
+    { 0x7C,0x83,0x82,0x83,0x7D },  // U+0150 latin capital letter o with double acute
+    { 0x38,0x46,0x45,0x46,0x39 },  // U+0151 latin small letter o with double acute
+    { 0x3E,0x41,0x7F,0x49,0x41 },  // U+0152 latin capital ligature oe
+    { 0x38,0x44,0x38,0x54,0x58 },  // U+0153 latin small ligature oe
+    { 0xFE,0x12,0x33,0x53,0x8C },  // U+0154 latin capital letter r with acute
+    { 0x7C,0x08,0x06,0x05,0x08 },  // U+0155 latin small letter r with acute
+    { 0x7F,0x09,0x99,0xA9,0x46 },  // U+0156 latin capital letter r with cedilla
+    { 0x7C,0x08,0x84,0x84,0x08 },  // U+0157 latin small letter r with cedilla
+    { 0xFF,0x12,0x33,0x52,0x8D },  // U+0158 latin capital letter r with caron
+    { 0x7C,0x09,0x06,0x05,0x08 },  // U+0159 latin small letter r with caron
+    { 0x8C,0x92,0x93,0x93,0x62 },  // U+015A latin capital letter s with acute
+    { 0x48,0x54,0x56,0x55,0x20 },  // U+015B latin small letter s with acute
+    { 0x8C,0x93,0x93,0x93,0x62 },  // U+015C latin capital letter s with circumflex
+    { 0x48,0x56,0x55,0x56,0x20 },  // U+015D latin small letter s with circumflex
+    { 0x46,0x49,0xC9,0xC9,0x31 },  // U+015E latin capital letter s with cedilla
+    { 0x48,0x54,0xD4,0xD4,0x20 },  // U+015F latin small letter s with cedilla
+    { 0x8D,0x92,0x93,0x92,0x63 },  // U+0160 latin capital letter s with caron
+    { 0x48,0x55,0x56,0x55,0x20 },  // U+0161 latin small letter s with caron
+    { 0x01,0x01,0xFF,0x81,0x01 },  // U+0162 latin capital letter t with cedilla
+    { 0x04,0x3F,0xC4,0xC0,0x20 },  // U+0163 latin small letter t with cedilla
+    { 0x03,0x02,0xFF,0x02,0x03 },  // U+0164 latin capital letter t with caron
+    { 0x04,0x3F,0x44,0x40,0x23 },  // U+0165 latin small letter t with caron
+    { 0x01,0x09,0x7F,0x09,0x01 },  // U+0166 latin capital letter t with stroke
+    { 0x14,0x3F,0x54,0x40,0x20 },  // U+0167 latin small letter t with stroke
+    { 0x7E,0x81,0x81,0x81,0x7F },  // U+0168 latin capital letter u with tilde
+    { 0x3C,0x42,0x41,0x22,0x7D },  // U+0169 latin small letter u with tilde
+    { 0x7F,0x81,0x81,0x81,0x7F },  // U+016A latin capital letter u with macron
+    { 0x3C,0x42,0x42,0x22,0x7C },  // U+016B latin small letter u with macron
+    { 0x7F,0x80,0x80,0x80,0x7F },  // U+016C latin capital letter u with breve
+    { 0x3C,0x41,0x42,0x21,0x7C },  // U+016D latin small letter u with breve
+    { 0x7E,0x80,0x81,0x80,0x7E },  // U+016E latin capital letter u with ring above
+    { 0x3C,0x40,0x43,0x23,0x7C },  // U+016F latin small letter u with ring above
+    { 0x7E,0x81,0x80,0x81,0x7F },  // U+0170 latin capital letter u with double acute
+    { 0x3C,0x42,0x41,0x22,0x7D },  // U+0171 latin small letter u with double acute
+    { 0x3F,0x40,0x40,0xC0,0xBF },  // U+0172 latin capital letter u with ogonek
+    { 0x3C,0x40,0x40,0xA0,0xFC },  // U+0173 latin small letter u with ogonek
+    { 0x7E,0x81,0x71,0x81,0x7E },  // U+0174 latin capital letter w with circumflex
+    { 0x3C,0x42,0x31,0x42,0x3C },  // U+0175 latin small letter w with circumflex
+    { 0x0E,0x11,0xE1,0x11,0x0E },  // U+0176 latin capital letter y with circumflex
+    { 0x1C,0xA2,0xA1,0xA2,0x7C },  // U+0177 latin small letter y with circumflex
+    { 0x0E,0x11,0xE0,0x11,0x0E },  // U+0178 latin capital letter y with diaeresis
+    { 0xC2,0xA2,0x93,0x8B,0x86 },  // U+0179 latin capital letter z with acute
+    { 0x44,0x64,0x56,0x4D,0x44 },  // U+017A latin small letter z with acute
+    { 0xC2,0xA2,0x93,0x8A,0x86 },  // U+017B latin capital letter z with dot above
+    { 0x44,0x64,0x56,0x4C,0x44 },  // U+017C latin small letter z with dot above
+    { 0xC3,0xA2,0x93,0x8A,0x87 },  // U+017D latin capital letter z with caron
+    { 0x44,0x65,0x56,0x4D,0x44 },  // U+017E latin small letter z with caron
+    { 0x00,0x7E,0x01,0x01,0x02 },  // U+017F latin small letter long s
+    { 0x14,0x3E,0x55,0x55,0x41 },  // U+20AC euro sign
+};
+
+const byte ledFontMetrics[] PROGMEM = {
+    0x02,  // 0x20 space
+    0x21,  // 0x21 !
+    0x13,  // 0x22 "
+    0x05,  // 0x23 #
+    0x05,  // 0x24 $
+    0x05,  // 0x25 %
+    0x05,  // 0x26 &
+    0x21,  // 0x27 '
+    0x13,  // 0x28 (
+    0x13,  // 0x29 )
+    0x05,  // 0x2A *
+    0x05,  // 0x2B +
+    0x12,  // 0x2C ,
+    0x05,  // 0x2D -
+    0x12,  // 0x2E .
+    0x05,  // 0x2F /
+    0x05,  // 0x30 0
+    0x13,  // 0x31 1
+    0x05,  // 0x32 2
+    0x05,  // 0x33 3
+    0x05,  // 0x34 4
+    0x05,  // 0x35 5
+    0x05,  // 0x36 6
+    0x05,  // 0x37 7
+    0x05,  // 0x38 8
+    0x05,  // 0x39 9
+    0x12,  // 0x3A :
+    0x12,  // 0x3B ;
+    0x04,  // 0x3C <
+    0x05,  // 0x3D =
+    0x14,  // 0x3E >
+    0x05,  // 0x3F ?
+    0x05,  // 0x40 @
+    0x05,  // 0x41 A
+    0x05,  // 0x42 B
+    0x05,  // 0x43 C
+    0x05,  // 0x44 D
+    0x05,  // 0x45 E
+    0x05,  // 0x46 F
+    0x05,  // 0x47 G
+    0x05,  // 0x48 H
+    0x13,  // 0x49 I
+    0x05,  // 0x4A J
+    0x05,  // 0x4B K
+    0x05,  // 0x4C L
+    0x05,  // 0x4D M
+    0x05,  // 0x4E N
+    0x05,  // 0x4F O
+    0x05,  // 0x50 P
+    0x05,  // 0x51 Q
+    0x05,  // 0x52 R
+    0x05,  // 0x53 S
+    0x05,  // 0x54 T
+    0x05,  // 0x55 U
+    0x05,  // 0x56 V
+    0x05,  // 0x57 W
+    0x05,  // 0x58 X
+    0x05,  // 0x59 Y
+    0x05,  // 0x5A Z
+    0x13,  // 0x5B [
+    0x05,  // 0x5C backslash
+    0x13,  // 0x5D ]
+    0x05,  // 0x5E ^
+    0x05,  // 0x5F _
+    0x12,  // 0x60 `
+    0x05,  // 0x61 a
+    0x05,  // 0x62 b
+    0x05,  // 0x63 c
+    0x05,  // 0x64 d
+    0x05,  // 0x65 e
+    0x05,  // 0x66 f
+    0x05,  // 0x67 g
+    0x05,  // 0x68 h
+    0x13,  // 0x69 i
+    0x04,  // 0x6A j
+    0x04,  // 0x6B k
+    0x13,  // 0x6C l
+    0x05,  // 0x6D m
+    0x05,  // 0x6E n
+    0x05,  // 0x6F o
+    0x05,  // 0x70 p
+    0x05,  // 0x71 q
+    0x05,  // 0x72 r
+    0x05,  // 0x73 s
+    0x05,  // 0x74 t
+    0x05,  // 0x75 u
+    0x05,  // 0x76 v
+    0x05,  // 0x77 w
+    0x05,  // 0x78 x
+    0x05,  // 0x79 y
+    0x05,  // 0x7A z
+    0x13,  // 0x7B {
+    0x21,  // 0x7C |
+    0x13,  // 0x7D }
+    0x05,  // 0x7E ~
+    0x05,  // 0x7F fallback
+    0x02,  // U+00A0
+    0x21,  // U+00A1
+    0x05,  // U+00A2
+    0x05,  // U+00A3
+    0x05,  // U+00A4
+    0x05,  // U+00A5
+    0x21,  // U+00A6
+    0x05,  // U+00A7
+    0x13,  // U+00A8
+    0x05,  // U+00A9
+    0x05,  // U+00AA
+    0x05,  // U+00AB
+    0x05,  // U+00AC
+    0x05,  // U+00AD
+    0x05,  // U+00AE
+    0x13,  // U+00AF
+    0x14,  // U+00B0
+    0x05,  // U+00B1
+    0x13,  // U+00B2
+    0x13,  // U+00B3
+    0x22,  // U+00B4
+    0x05,  // U+00B5
+    0x05,  // U+00B6
+    0x21,  // U+00B7
+    0x22,  // U+00B8
+    0x13,  // U+00B9
+    0x05,  // U+00BA
+    0x05,  // U+00BB
+    0x05,  // U+00BC
+    0x05,  // U+00BD
+    0x05,  // U+00BE
+    0x05,  // U+00BF
+    0x05,  // U+00C0
+    0x05,  // U+00C1
+    0x05,  // U+00C2
+    0x05,  // U+00C3
+    0x05,  // U+00C4
+    0x05,  // U+00C5
+    0x05,  // U+00C6
+    0x05,  // U+00C7
+    0x05,  // U+00C8
+    0x05,  // U+00C9
+    0x05,  // U+00CA
+    0x05,  // U+00CB
+    0x13,  // U+00CC
+    0x13,  // U+00CD
+    0x13,  // U+00CE
+    0x13,  // U+00CF
+    0x05,  // U+00D0
+    0x05,  // U+00D1
+    0x05,  // U+00D2
+    0x05,  // U+00D3
+    0x05,  // U+00D4
+    0x05,  // U+00D5
+    0x05,  // U+00D6
+    0x05,  // U+00D7
+    0x05,  // U+00D8
+    0x05,  // U+00D9
+    0x05,  // U+00DA
+    0x05,  // U+00DB
+    0x05,  // U+00DC
+    0x05,  // U+00DD
+    0x05,  // U+00DE
+    0x05,  // U+00DF
+    0x05,  // U+00E0
+    0x05,  // U+00E1
+    0x05,  // U+00E2
+    0x05,  // U+00E3
+    0x05,  // U+00E4
+    0x05,  // U+00E5
+    0x05,  // U+00E6
+    0x05,  // U+00E7
+    0x05,  // U+00E8
+    0x05,  // U+00E9
+    0x05,  // U+00EA
+    0x05,  // U+00EB
+    0x13,  // U+00EC
+    0x13,  // U+00ED
+    0x13,  // U+00EE
+    0x13,  // U+00EF
+    0x05,  // U+00F0
+    0x05,  // U+00F1
+    0x05,  // U+00F2
+    0x05,  // U+00F3
+    0x05,  // U+00F4
+    0x05,  // U+00F5
+    0x05,  // U+00F6
+    0x05,  // U+00F7
+    0x05,  // U+00F8
+    0x05,  // U+00F9
+    0x05,  // U+00FA
+    0x05,  // U+00FB
+    0x05,  // U+00FC
+    0x05,  // U+00FD
+    0x05,  // U+00FE
+    0x05,  // U+00FF
+    0x05,  // U+0100
+    0x05,  // U+0101
+    0x05,  // U+0102
+    0x05,  // U+0103
+    0x05,  // U+0104
+    0x05,  // U+0105
+    0x05,  // U+0106
+    0x05,  // U+0107
+    0x05,  // U+0108
+    0x05,  // U+0109
+    0x05,  // U+010A
+    0x05,  // U+010B
+    0x05,  // U+010C
+    0x05,  // U+010D
+    0x05,  // U+010E
+    0x05,  // U+010F
+    0x05,  // U+0110
+    0x05,  // U+0111
+    0x05,  // U+0112
+    0x05,  // U+0113
+    0x05,  // U+0114
+    0x05,  // U+0115
+    0x05,  // U+0116
+    0x05,  // U+0117
+    0x05,  // U+0118
+    0x05,  // U+0119
+    0x05,  // U+011A
+    0x05,  // U+011B
+    0x05,  // U+011C
+    0x05,  // U+011D
+    0x05,  // U+011E
+    0x05,  // U+011F
+    0x05,  // U+0120
+    0x05,  // U+0121
+    0x05,  // U+0122
+    0x05,  // U+0123
+    0x05,  // U+0124
+    0x05,  // U+0125
+    0x05,  // U+0126
+    0x05,  // U+0127
+    0x14,  // U+0128
+    0x14,  // U+0129
+    0x05,  // U+012A
+    0x13,  // U+012B
+    0x05,  // U+012C
+    0x13,  // U+012D
+    0x14,  // U+012E
+    0x14,  // U+012F
+    0x13,  // U+0130
+    0x13,  // U+0131
+    0x05,  // U+0132
+    0x05,  // U+0133
+    0x05,  // U+0134
+    0x04,  // U+0135
+    0x05,  // U+0136
+    0x04,  // U+0137
+    0x04,  // U+0138
+    0x05,  // U+0139
+    0x13,  // U+013A
+    0x05,  // U+013B
+    0x13,  // U+013C
+    0x05,  // U+013D
+    0x14,  // U+013E
+    0x05,  // U+013F
+    0x14,  // U+0140
+    0x05,  // U+0141
+    0x13,  // U+0142
+    0x05,  // U+0143
+    0x05,  // U+0144
+    0x05,  // U+0145
+    0x05,  // U+0146
+    0x05,  // U+0147
+    0x05,  // U+0148
+    0x05,  // U+0149
+    0x05,  // U+014A
+    0x05,  // U+014B
+    0x05,  // U+014C
+    0x05,  // U+014D
+    0x05,  // U+014E
+    0x05,  // U+014F
+    0x05,  // U+0150
+    0x05,  // U+0151
+    0x05,  // U+0152
+    0x05,  // U+0153
+    0x05,  // U+0154
+    0x05,  // U+0155
+    0x05,  // U+0156
+    0x05,  // U+0157
+    0x05,  // U+0158
+    0x05,  // U+0159
+    0x05,  // U+015A
+    0x05,  // U+015B
+    0x05,  // U+015C
+    0x05,  // U+015D
+    0x05,  // U+015E
+    0x05,  // U+015F
+    0x05,  // U+0160
+    0x05,  // U+0161
+    0x05,  // U+0162
+    0x05,  // U+0163
+    0x05,  // U+0164
+    0x05,  // U+0165
+    0x05,  // U+0166
+    0x05,  // U+0167
+    0x05,  // U+0168
+    0x05,  // U+0169
+    0x05,  // U+016A
+    0x05,  // U+016B
+    0x05,  // U+016C
+    0x05,  // U+016D
+    0x05,  // U+016E
+    0x05,  // U+016F
+    0x05,  // U+0170
+    0x05,  // U+0171
+    0x05,  // U+0172
+    0x05,  // U+0173
+    0x05,  // U+0174
+    0x05,  // U+0175
+    0x05,  // U+0176
+    0x05,  // U+0177
+    0x05,  // U+0178
+    0x05,  // U+0179
+    0x05,  // U+017A
+    0x05,  // U+017B
+    0x05,  // U+017C
+    0x05,  // U+017D
+    0x05,  // U+017E
+    0x14,  // U+017F
+    0x05,  // U+20AC
+};
+
+const uint16_t ledFontCodes[] PROGMEM = {
+    0x00A0,0x00A1,0x00A2,0x00A3,0x00A4,0x00A5,0x00A6,0x00A7,
+    0x00A8,0x00A9,0x00AA,0x00AB,0x00AC,0x00AD,0x00AE,0x00AF,
+    0x00B0,0x00B1,0x00B2,0x00B3,0x00B4,0x00B5,0x00B6,0x00B7,
+    0x00B8,0x00B9,0x00BA,0x00BB,0x00BC,0x00BD,0x00BE,0x00BF,
+    0x00C0,0x00C1,0x00C2,0x00C3,0x00C4,0x00C5,0x00C6,0x00C7,
+    0x00C8,0x00C9,0x00CA,0x00CB,0x00CC,0x00CD,0x00CE,0x00CF,
+    0x00D0,0x00D1,0x00D2,0x00D3,0x00D4,0x00D5,0x00D6,0x00D7,
+    0x00D8,0x00D9,0x00DA,0x00DB,0x00DC,0x00DD,0x00DE,0x00DF,
+    0x00E0,0x00E1,0x00E2,0x00E3,0x00E4,0x00E5,0x00E6,0x00E7,
+    0x00E8,0x00E9,0x00EA,0x00EB,0x00EC,0x00ED,0x00EE,0x00EF,
+    0x00F0,0x00F1,0x00F2,0x00F3,0x00F4,0x00F5,0x00F6,0x00F7,
+    0x00F8,0x00F9,0x00FA,0x00FB,0x00FC,0x00FD,0x00FE,0x00FF,
+    0x0100,0x0101,0x0102,0x0103,0x0104,0x0105,0x0106,0x0107,
+    0x0108,0x0109,0x010A,0x010B,0x010C,0x010D,0x010E,0x010F,
+    0x0110,0x0111,0x0112,0x0113,0x0114,0x0115,0x0116,0x0117,
+    0x0118,0x0119,0x011A,0x011B,0x011C,0x011D,0x011E,0x011F,
+    0x0120,0x0121,0x0122,0x0123,0x0124,0x0125,0x0126,0x0127,
+    0x0128,0x0129,0x012A,0x012B,0x012C,0x012D,0x012E,0x012F,
+    0x0130,0x0131,0x0132,0x0133,0x0134,0x0135,0x0136,0x0137,
+    0x0138,0x0139,0x013A,0x013B,0x013C,0x013D,0x013E,0x013F,
+    0x0140,0x0141,0x0142,0x0143,0x0144,0x0145,0x0146,0x0147,
+    0x0148,0x0149,0x014A,0x014B,0x014C,0x014D,0x014E,0x014F,
+    0x0150,0x0151,0x0152,0x0153,0x0154,0x0155,0x0156,0x0157,
+    0x0158,0x0159,0x015A,0x015B,0x015C,0x015D,0x015E,0x015F,
+    0x0160,0x0161,0x0162,0x0163,0x0164,0x0165,0x0166,0x0167,
+    0x0168,0x0169,0x016A,0x016B,0x016C,0x016D,0x016E,0x016F,
+    0x0170,0x0171,0x0172,0x0173,0x0174,0x0175,0x0176,0x0177,
+    0x0178,0x0179,0x017A,0x017B,0x017C,0x017D,0x017E,0x017F,
+    0x20AC,
+};
+
+int ledFontFind(unsigned int code) {
+    int low=0, high=sizeof(ledFontCodes)/sizeof(ledFontCodes[0])-1, middle;
+    unsigned int found;
+
+    //the codes are sorted, a binary search takes at most 8 steps
+    while(low<=high) {
+	middle=(low+high)/2;
+	found=pgm_read_word(ledFontCodes+middle);
+	if(found==code)
+	    return FONT_EXTENDED+middle;
+	if(found<code)
+	    low=middle+1;
+	else
+	    high=middle-1;
+    }
+    return FONT_FALLBACK;
+}
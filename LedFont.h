@@ -0,0 +1,92 @@
+/*
+ *    LedFont.h - The 5x8 font used by LedControl::printChar
+ *
+ *    Released under the same terms as LedControl.h
+ */
+
+#ifndef LedFont_h
+#define LedFont_h
+
+#if (ARDUINO >= 100)
+#include <Arduino.h>
+#else
+#include <WProgram.h>
+#endif
+
+/* Number of columns stored for every glyph */
+#define FONT_COLUMNS  5
+/* The table starts with the space character */
+#define FONT_FIRST    0x20
+/* Glyph drawn for characters the font does not know */
+#define FONT_FALLBACK (0x7F-FONT_FIRST)
+/* The glyphs of ledFontCodes follow the fallback glyph */
+#define FONT_EXTENDED (FONT_FALLBACK+1)
+
+/*
+ * One glyph for every character from ' ' to '~', the fallback glyph 
+ * and then one glyph for every code point in ledFontCodes. Each byte 
+ * is a column, bit 0 is the top led. The table lives in flash on AVR 
+ * and ESP.
+ */
+extern const byte ledFont[][FONT_COLUMNS] PROGMEM;
+
+/*
+ * The part of every glyph that is not blank, for proportional text.
+ * The high nibble is the first column, the low nibble the number of 
+ * columns. Blank glyphs like the space are 2 columns wide.
+ */
+extern const byte ledFontMetrics[] PROGMEM;
+
+/*
+ * The Unicode code points above '~' that have a glyph, sorted. 
+ * They cover Latin-1 and Latin Extended-A, so letters with accents, 
+ * the n with tilde, the inverted ? and ! and the degree sign can be 
+ * shown.
+ */
+extern const uint16_t ledFontCodes[] PROGMEM;
+
+/*
+ * Look up a code point above '~' in ledFontCodes.
+ * Params :
+ * code	the Unicode code point
+ * Returns :
+ * int	the index of its glyph, FONT_FALLBACK if there is none
+ */
+int ledFontFind(unsigned int code);
+
+/*
+ * Get the index of a character in the font tables.
+ * Params :
+ * code	the Unicode code point of the character. A char holding a 
+ *	Latin-1 character has to be cast to byte first.
+ */
+inline int ledFontIndex(unsigned int code) {
+    if(code>=FONT_FIRST && code<0x7F)
+	return code-FONT_FIRST;
+    return ledFontFind(code);
+}
+
+/*
+ * Get the glyph for a character.
+ * Params :
+ * code	the Unicode code point of the character
+ * Returns :
+ * byte*	the FONT_COLUMNS columns of the glyph, in flash. 
+ *		Read them with pgm_read_byte().
+ */
+inline const byte *ledFontGlyph(unsigned int code) {
+    return ledFont[ledFontIndex(code)];
+}
+
+/*
+ * Get the width of a character in a proportional text
+ * Params :
+ * code	the Unicode code point of the character
+ * Returns :
+ * byte	the number of columns of the glyph without its blank columns
+ */
+inline byte ledFontWidth(unsigned int code) {
+    return pgm_read_byte(ledFontMetrics+ledFontIndex(code))&0x0F;
+}
+
+#endif	//LedFont.h
@@ -0,0 +1,138 @@
+/*
+ *    LedScroll.cpp - Scrolls text over a LedControl display without 
+ *    blocking the sketch
+ *
+ *    Released under the same terms as LedControl.h
+ */
+
+#include "LedScroll.h"
+
+LedScroll::LedScroll(LedControl &lc, int addr, int pos) 
+    : canvas(lc,addr,1) {
+    init(pos);
+}
+
+LedScroll::LedScroll(const LedCanvas &canvas, int pos) 
+    : canvas(canvas) {
+    init(pos);
+}
+
+void LedScroll::init(int pos) {
+    this->pos=pos;
+    text="";
+    length=0;
+    sentido='<';
+    frame=0;
+    frames=0;
+    trailing=0;
+    proportional=false;
+    interval=0;
+    last=0;
+    running=false;
+}
+
+void LedScroll::start(const char text[], int speed, char sentido) {
+    this->text=text;
+    this->sentido=sentido;
+    length=0;
+    while(text[length]!='\0')
+	length++;
+    //every column of the text is a frame
+    frames=ledTextWidth(text,length,proportional);
+    interval=speed;
+    frame=0;
+    trailing=0;
+    running=(sentido=='<' || sentido=='>');
+    if(!running)
+	return;
+    //the first frame is drawn in full, after that the columns scroll in at the edge
+    if(sentido=='<') {
+	canvas.printString(pos,text,length,proportional);
+	columns.start(text,length,canvas.getWidth()-pos,false,proportional);
+    }
+    else {
+	canvas.printString(-(frames-1)+pos,text,length,proportional);
+	columns.start(text,length,(frames-1)-1-pos,true,proportional);
+    }
+    canvas.show();
+    last=millis();
+}
+
+void LedScroll::start(LedTextSource &source, int speed) {
+    text="";
+    length=0;
+    sentido='<';
+    frames=-1;
+    frame=0;
+    trailing=0;
+    interval=speed;
+    columns.start(source,proportional);
+    running=true;
+    last=millis();
+}
+
+bool LedScroll::update() {
+    unsigned long now;
+    unsigned long steps;
+
+    if(!running)
+	return false;
+    now=millis();
+    if(now-last<interval)
+	return true;
+    //catch up with the clock
+    steps=interval>0 ? (now-last)/interval : 1;
+    last+=steps*interval;
+    if(frames<0) {
+	//a source, we go on until its last column has left the display
+	advance(steps);
+	if(trailing>=canvas.getWidth()) {
+	    running=false;
+	    return false;
+	}
+	return true;
+    }
+    if(steps>=(unsigned long)(frames-frame)) {
+	if(frame<frames-1) {
+	    //the frames we missed are skipped, but the last one is always
+	    //shown for a full interval from now on
+	    advance(frames-1-frame);
+	    frame=frames-1;
+	    last=now;
+	    return true;
+	}
+	frame=frames;
+	running=false;
+	return false;
+    }
+    frame+=steps;
+    advance(steps);
+    return true;
+}
+
+void LedScroll::setProportional(bool enable) {
+    proportional=enable;
+}
+
+void LedScroll::stop() {
+    running=false;
+}
+
+bool LedScroll::isFinished() {
+    return !running;
+}
+
+void LedScroll::advance(int steps) {
+    LEDCONTROL_STAT(unsigned long start=LEDCONTROL_CYCLES();)
+
+    //frames we missed go out together with the current one
+    while(steps-->0) {
+	bool ended=columns.isEnded();
+	canvas.scrollColumn(columns.next(),sentido);
+	//after the end of a source only blank columns come in
+	if(ended && ++trailing>=canvas.getWidth())
+	    break;
+    }
+    canvas.show();
+    LEDCONTROL_STAT(canvas.getControl().countFrame(LEDCONTROL_CYCLES()-start);)
+}
@@ -0,0 +1,125 @@
+/*
+ *    LedScroll.h - Scrolls text over a LedControl display without 
+ *    blocking the sketch
+ *
+ *    Released under the same terms as LedControl.h
+ */
+
+#ifndef LedScroll_h
+#define LedScroll_h
+
+#include "LedControl.h"
+#include "LedCanvas.h"
+#include "LedText.h"
+
+/*
+ * A scroll in progress. Instead of waiting between the frames like
+ * LedControl::printStringScroll, update() is called from loop() and
+ * draws a new frame only when it is due. The text can scroll over a 
+ * single display or over a LedCanvas that spans several modules.
+ */
+class LedScroll {
+ private :
+    /* The display or the modules we draw on */
+    LedCanvas canvas;
+    /* The start position of the text */
+    int pos;
+    /* The text, it must stay valid until the scroll is finished */
+    const char *text;
+    /* Number of bytes in text */
+    int length;
+    /* '<' scrolls to the left, '>' to the right */
+    char sentido;
+    /* The frame on the display and the number of frames in total, -1 for a source */
+    int frame;
+    int frames;
+    /* Blank columns scrolled in since a source ended */
+    int trailing;
+    /* true if the text is drawn with proportional character widths */
+    bool proportional;
+    /* Milliseconds between two frames */
+    unsigned long interval;
+    /* millis() when the current frame was due */
+    unsigned long last;
+    /* true while the scroll has frames left */
+    bool running;
+    /* The columns that scroll in */
+    LedTextColumns columns;
+
+    /* Setup the state shared by the constructors */
+    void init(int pos);
+    /* Move the display on by a number of frames */
+    void advance(int steps);
+
+ public:
+    /* 
+     * Params :
+     * lc	the controler to draw on
+     * addr	address of the display
+     * pos	position of the text when the scroll starts, like 
+     *		in LedControl::printStringScroll
+     */
+    LedScroll(LedControl &lc, int addr=0, int pos=0);
+
+    /* 
+     * Params :
+     * canvas	the modules to scroll over, the text flows from one
+     *		module into the next
+     * pos	column of the canvas where the text starts
+     */
+    LedScroll(const LedCanvas &canvas, int pos=0);
+
+    /* 
+     * Start scrolling a text, the first frame is drawn right away.
+     * Params :
+     * text	the text to scroll, UTF-8. It is not copied and must stay 
+     *		valid until the scroll is finished.
+     * speed	milliseconds between two frames
+     * sentido	'<' scrolls to the left, '>' to the right
+     */
+    void start(const char text[], int speed, char sentido);
+
+    /* 
+     * Start scrolling a text that comes from a source, for instance
+     * the characters arriving on Serial. The text scrolls in from the 
+     * right, every character is taken from the source when it is 
+     * needed. Nothing is buffered and the length need not be known, 
+     * the scroll finishes when the source has ended and the last 
+     * character has left the display.
+     * Params :
+     * source	where the characters come from, it must stay valid
+     *		until the scroll is finished
+     * speed	milliseconds between two frames
+     */
+    void start(LedTextSource &source, int speed);
+
+    /* 
+     * Draw the next frame if it is due. Every frame only moves the 
+     * display by one column and adds the column that scrolls in. If
+     * the sketch fell behind, the missed frames are sent to the 
+     * display together. Returns immediately.
+     * Returns :
+     * bool	true while the scroll is running
+     */
+    bool update();
+
+    /*
+     * Draw the text with proportional character widths, narrow 
+     * characters take less columns and the text scrolls by in less
+     * frames. Takes effect with the next start().
+     * Params :
+     * enable	true for proportional text, false for 6 columns per character
+     */
+    void setProportional(bool enable);
+
+    /* Stop the scroll, the display keeps the current frame */
+    void stop();
+
+    /*
+     * Returns :
+     * bool	true once the last frame was shown for its full time
+     */
+    bool isFinished();
+};
+
+#endif	//LedScroll.h
@@ -0,0 +1,126 @@
+/*
+ *    LedSprite.h - 8x8 images held in a single 64 bit word
+ *
+ *    Released under the same terms as LedControl.h
+ */
+
+#ifndef LedSprite_h
+#define LedSprite_h
+
+#if (ARDUINO >= 100)
+#include <Arduino.h>
+#else
+#include <WProgram.h>
+#endif
+
+#include "LedFont.h"
+
+/*
+ * A sprite is the image of one 8x8 module: byte X of the word is
+ * column X (what LedControl::setRow() takes for row X), bit 0 of
+ * every byte is the top led. Moving and combining sprites works on
+ * the whole word at once, there are no loops over the leds.
+ */
+typedef uint64_t LedSprite;
+
+/* The ways a sprite is combined with what is already drawn */
+/* The leds of the sprite replace the ones under it, blank ones included */
+#define LEDSPRITE_COPY 0
+/* The lit leds of the sprite are switched on */
+#define LEDSPRITE_OR   1
+/* Only leds lit in the sprite stay on, outside the sprite nothing changes */
+#define LEDSPRITE_AND  2
+/* The lit leds of the sprite are toggled */
+#define LEDSPRITE_XOR  3
+
+/* 0x01 in every byte, multiply a byte by it to repeat it in every column */
+#define LEDSPRITE_COLUMNS 0x0101010101010101ULL
+
+/* Build a sprite from its 8 columns, the first one is the left edge */
+#define LEDSPRITE(c0,c1,c2,c3,c4,c5,c6,c7) \
+    ((LedSprite)(c0)|((LedSprite)(c1)<<8)|((LedSprite)(c2)<<16)| \
+     ((LedSprite)(c3)<<24)|((LedSprite)(c4)<<32)|((LedSprite)(c5)<<40)| \
+     ((LedSprite)(c6)<<48)|((LedSprite)(c7)<<56))
+
+/*
+ * Move a sprite. Leds that move out of the 8x8 square are lost.
+ * Params :
+ * sprite	the sprite
+ * x		columns to move right, negative to move left
+ * y		rows to move down, negative to move up
+ */
+inline LedSprite ledSpriteShift(LedSprite sprite, int x, int y) {
+    if(x<=-8 || x>=8 || y<=-8 || y>=8)
+	return 0;
+    //a column is a byte, so a move to the side is a shift by whole bytes
+    if(x>0)
+	sprite<<=8*x;
+    else if(x<0)
+	sprite>>=-8*x;
+    //a move up or down shifts all bytes at once, the mask drops the bits
+    //that would cross into the next column
+    if(y>0)
+	sprite=(sprite<<y)&(LEDSPRITE_COLUMNS*(byte)(0xFF<<y));
+    else if(y<0)
+	sprite=(sprite>>-y)&(LEDSPRITE_COLUMNS*(byte)(0xFF>>-y));
+    return sprite;
+}
+
+/*
+ * Draw a sprite onto another one.
+ * Params :
+ * target	what is already drawn
+ * sprite	the sprite to draw
+ * x		column of target where the left edge of the sprite goes
+ * y		row of target where the top of the sprite goes
+ * op		LEDSPRITE_COPY, LEDSPRITE_OR, LEDSPRITE_AND or LEDSPRITE_XOR
+ * Returns :
+ * LedSprite	the combined image
+ */
+inline LedSprite ledSpriteBlit(LedSprite target, LedSprite sprite, int x, int y, byte op) {
+    LedSprite moved=ledSpriteShift(sprite,x,y);
+    LedSprite area;
+
+    switch(op) {
+    case LEDSPRITE_OR:
+	return target|moved;
+    case LEDSPRITE_XOR:
+	return target^moved;
+    case LEDSPRITE_AND:
+	area=ledSpriteShift(~(LedSprite)0,x,y);
+	return target&(moved|~area);
+    default:
+	area=ledSpriteShift(~(LedSprite)0,x,y);
+	return (target&~area)|moved;
+    }
+}
+
+/*
+ * Read a sprite from flash.
+ * Params :
+ * columns	the 8 columns of the sprite in PROGMEM, left edge first
+ */
+inline LedSprite ledSpriteLoad(const byte *columns) {
+    LedSprite sprite=0;
+
+    for(int x=7;x>=0;x--)
+	sprite=(sprite<<8)|pgm_read_byte(columns+x);
+    return sprite;
+}
+
+/*
+ * Get the glyph of a character as a sprite. The FONT_COLUMNS columns
+ * of the glyph start at column 0, the other columns are blank.
+ * Params :
+ * code	the Unicode code point of the character
+ */
+inline LedSprite ledSpriteChar(unsigned int code) {
+    const byte *glyph=ledFontGlyph(code);
+    LedSprite sprite=0;
+
+    for(int x=FONT_COLUMNS-1;x>=0;x--)
+	sprite=(sprite<<8)|pgm_read_byte(glyph+x);
+    return sprite;
+}
+
+#endif	//LedSprite.h
@@ -0,0 +1,224 @@
+/*
+ *    LedText.cpp - Turns a text into the columns drawn on a LED matrix
+ *
+ *    Released under the same terms as LedControl.h
+ */
+
+#include "LedText.h"
+#include "LedFont.h"
+
+LedTextColumns::LedTextColumns() {
+    start("",0,0);
+}
+
+unsigned int ledUtf8Next(const char *text, int length, int index, byte *size) {
+    byte c=(byte)text[index], b;
+    unsigned int code;
+    int need, i;
+
+    *size=1;
+    if(c<0x80)
+	return c;
+    if(c>=0xC2 && c<=0xDF) {
+	need=1;
+	code=c&0x1F;
+    }
+    else if(c>=0xE0 && c<=0xEF) {
+	need=2;
+	code=c&0x0F;
+    }
+    else if(c>=0xF0 && c<=0xF4) {
+	need=3;
+	code=0;
+    }
+    else
+	//not a lead byte, take it as Latin-1
+	return c;
+    for(i=1;i<=need;i++) {
+	//a '\0' is no continuation byte, so this also stops at the end of the string
+	if(length>=0 && index+i>=length)
+	    return c;
+	b=(byte)text[index+i];
+	if((b&0xC0)!=0x80)
+	    return c;
+	code=(code<<6)|(b&0x3F);
+    }
+    *size=need+1;
+    //there are no glyphs outside the first 65536 code points
+    return need==3 ? LEDTEXT_INVALID : code;
+}
+
+int ledUtf8Previous(const char *text, int index) {
+    int start=index-1;
+    byte size;
+
+    //step back over at most 3 continuation bytes to the lead byte
+    while(start>0 && index-start<4 && ((byte)text[start]&0xC0)==0x80)
+	start--;
+    ledUtf8Next(text,index,start,&size);
+    //if the sequence does not end at index the last byte stands alone
+    return start+size==index ? start : index-1;
+}
+
+int LedUtf8Decoder::next(LedTextSource &source) {
+    int c;
+
+    for(;;) {
+	if(stashed) {
+	    c=stash;
+	    stashed=false;
+	}
+	else
+	    c=source.next();
+	if(c==LEDTEXT_WAIT)
+	    //keep what was decoded so far until the rest arrives
+	    return c;
+	if(need>0) {
+	    if(c>=0 && (c&0xC0)==0x80) {
+		code=(code<<6)|(c&0x3F);
+		count++;
+		if(--need==0)
+		    return lead>=0xF0 ? LEDTEXT_INVALID : code;
+		continue;
+	    }
+	    //the sequence is cut short, c starts the next character
+	    stash=c;
+	    stashed=true;
+	    //a lead byte on its own is a Latin-1 character
+	    c=count==1 ? lead : LEDTEXT_INVALID;
+	    need=0;
+	    return c;
+	}
+	if(c<0x80)
+	    //ASCII or LEDTEXT_END
+	    return c;
+	lead=c;
+	count=1;
+	if(c>=0xC2 && c<=0xDF) {
+	    need=1;
+	    code=c&0x1F;
+	}
+	else if(c>=0xE0 && c<=0xEF) {
+	    need=2;
+	    code=c&0x0F;
+	}
+	else if(c>=0xF0 && c<=0xF4) {
+	    need=3;
+	    code=0;
+	}
+	else
+	    return c;
+    }
+}
+
+void LedTextColumns::start(const char *text, int length, int column, bool reverse, 
+			   bool proportional) {
+    int index;
+
+    this->text=text;
+    this->length=length;
+    this->reverse=reverse;
+    this->proportional=proportional;
+    source=0;
+    ended=false;
+    //outside the text every blank column is a cell of its own
+    index=0;
+    if(column<0)
+	index=column;
+    else {
+	//characters take more than one byte, so walk up to the column
+	load(0);
+	while(index<length && column>=cell) {
+	    column-=cell;
+	    index+=size;
+	    load(index);
+	}
+	if(index>=length)
+	    index+=column;
+    }
+    load(index);
+    sub=index>=0 && index<length ? column : 0;
+}
+
+void LedTextColumns::start(LedTextSource &source, bool proportional) {
+    text="";
+    length=0;
+    reverse=false;
+    this->proportional=proportional;
+    ended=false;
+    this->source=&source;
+    decoder.reset();
+    sub=0;
+    load(0);
+}
+
+void LedTextColumns::load(int index) {
+    int c;
+    byte metrics;
+
+    this->index=index;
+    size=1;
+    glyph=0;
+    if(source==0) {
+	if(index>=0 && index<length)
+	    c=ledUtf8Next(text,length,index,&size);
+	else
+	    c=LEDTEXT_END;
+    }
+    else if(ended)
+	c=LEDTEXT_END;
+    else {
+	c=decoder.next(*source);
+	if(c==LEDTEXT_END)
+	    ended=true;
+	else if(c==LEDTEXT_WAIT)
+	    c=' ';
+    }
+    offset=0;
+    cell=6;
+    if(c!=LEDTEXT_END) {
+	glyph=ledFontGlyph(c);
+	if(proportional) {
+	    metrics=pgm_read_byte(ledFontMetrics+ledFontIndex(c));
+	    offset=metrics>>4;
+	    cell=1+(metrics&0x0F);
+	}
+    }
+    else
+	cell=1;
+}
+
+byte LedTextColumns::next() {
+    byte value=0x00;
+
+    if(glyph!=0 && sub>0)
+	value=pgm_read_byte(glyph+offset+sub-1);
+    if(!reverse) {
+	if(++sub>=cell) {
+	    sub=0;
+	    load(index+size);
+	}
+    }
+    else {
+	if(--sub<0) {
+	    if(index>0 && index<=length)
+		load(ledUtf8Previous(text,index));
+	    else
+		load(index-1);
+	    sub=cell-1;
+	}
+    }
+    return value;
+}
+
+int ledTextWidth(const char *text, int length, bool proportional) {
+    int width=1;
+    unsigned int c;
+    byte size;
+
+    for(int i=0;length<0 ? text[i]!='\0' : i<length;i+=size) {
+	c=ledUtf8Next(text,length,i,&size);
+	width+=proportional ? 1+ledFontWidth(c) : 6;
+    }
+    return width;
+}
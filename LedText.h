@@ -0,0 +1,290 @@
+/*
+ *    LedText.h - Turns a text into the columns drawn on a LED matrix
+ *
+ *    Released under the same terms as LedControl.h
+ */
+
+#ifndef LedText_h
+#define LedText_h
+
+#if (ARDUINO >= 100)
+#include <Arduino.h>
+#else
+#include <WProgram.h>
+#endif
+
+#include "LedControl.h"
+
+/* Returned by LedTextSource::next() when the text has ended */
+#define LEDTEXT_END  -1
+/* Returned by LedTextSource::next() when no character is there yet */
+#define LEDTEXT_WAIT -2
+/* Code point of a UTF-8 sequence that is cut short or has no glyph */
+#define LEDTEXT_INVALID 0xFFFD
+
+/*
+ * Decode the character that starts at a byte of a UTF-8 text. A byte
+ * that does not start a valid sequence is taken as a Latin-1 character
+ * on its own, so texts saved as Latin-1 still show up right.
+ * Params :
+ * text		the text
+ * length	number of bytes in text, -1 if it ends with a '\0'
+ * index	the byte where the character starts
+ * size		set to the number of bytes of the character
+ * Returns :
+ * unsigned int	the Unicode code point of the character
+ */
+unsigned int ledUtf8Next(const char *text, int length, int index, byte *size);
+
+/*
+ * Find the character in front of a byte of a UTF-8 text.
+ * Params :
+ * text		the text
+ * index	a byte where a character starts, or the length of the text
+ * Returns :
+ * int	the byte where the character in front of it starts
+ */
+int ledUtf8Previous(const char *text, int index);
+
+/*
+ * Supplies the characters of a text one at a time, so a text can be 
+ * scrolled without having all of it in memory and without knowing 
+ * its length up front. Characters outside ASCII come as UTF-8 bytes.
+ */
+class LedTextSource {
+ public:
+    /*
+     * Returns :
+     * int	the next byte of the text, LEDTEXT_END once the text is over or
+     *		LEDTEXT_WAIT if the next character is not there yet. 
+     *		A LEDTEXT_WAIT is shown as a space.
+     */
+    virtual int next()=0;
+};
+
+/* The characters of a string in memory */
+class LedStringSource : public LedTextSource {
+ private :
+    const char *text;
+
+ public:
+    /* 
+     * Params :
+     * text	the string, it is not copied
+     */
+    LedStringSource(const char *text) : text(text) {}
+
+    virtual int next() {
+	if(*text=='\0')
+	    return LEDTEXT_END;
+	return (byte)*text++;
+    }
+};
+
+/* The characters arriving on a Stream, for instance Serial */
+class LedStreamSource : public LedTextSource {
+ private :
+    Stream *stream;
+    /* The text ends with this character, -1 if it never ends */
+    int terminator;
+
+ public:
+    /* 
+     * Params :
+     * stream		where the characters come from
+     * terminator	character that ends the text, -1 to scroll forever
+     */
+    LedStreamSource(Stream &stream, int terminator=-1) 
+	: stream(&stream), terminator(terminator) {}
+
+    virtual int next() {
+	int c;
+	if(stream->available()<=0)
+	    return LEDTEXT_WAIT;
+	c=stream->read();
+	if(c==terminator)
+	    return LEDTEXT_END;
+	return c;
+    }
+};
+
+/*
+ * A ring buffer of SIZE characters, SIZE is 2..256. One side (the 
+ * sketch or an interrupt) writes characters, the scroll takes them out.
+ * As long as there is only one writer and one reader no locking is 
+ * needed, the indices are single bytes so even an AVR reads them in 
+ * one go.
+ */
+template<int SIZE> class LedRingSource : public LedTextSource {
+ private :
+    char buffer[SIZE];
+    volatile byte head;
+    volatile byte tail;
+    volatile bool closed;
+
+ public:
+    LedRingSource() : head(0), tail(0), closed(false) {}
+
+    /* 
+     * Add a character to the text.
+     * Returns :
+     * bool	false if the buffer is full and the character was dropped
+     */
+    bool write(char c) {
+	byte next=(head+1)%SIZE;
+	if(next==tail)
+	    return false;
+	buffer[head]=c;
+	//the character is in the buffer before the reader can see it
+	LEDCONTROL_BARRIER();
+	head=next;
+	return true;
+    }
+
+    /* End the text once all characters written so far are shown */
+    void close() { closed=true; }
+
+    virtual int next() {
+	int c;
+	if(tail==head)
+	    return closed ? LEDTEXT_END : LEDTEXT_WAIT;
+	c=(byte)buffer[tail];
+	//the character is read before the writer may reuse its place
+	LEDCONTROL_BARRIER();
+	tail=(tail+1)%SIZE;
+	return c;
+    }
+};
+
+/*
+ * Turns the bytes coming from a LedTextSource into code points, one 
+ * byte at a time, so a character that arrives in pieces on a Stream 
+ * is shown once it is complete. Invalid bytes are handled like
+ * ledUtf8Next() does.
+ */
+class LedUtf8Decoder {
+ private :
+    /* The code point decoded so far */
+    unsigned int code;
+    /* 
+     * The first byte of the sequence, how many of its bytes were read 
+     * and how many are still missing
+     */
+    byte lead;
+    byte count;
+    byte need;
+    /* A byte that was read but belongs to the next character */
+    int stash;
+    bool stashed;
+
+ public:
+    LedUtf8Decoder() { reset(); }
+
+    /* Forget a sequence that was started */
+    void reset() { need=0; stashed=false; }
+
+    /*
+     * Params :
+     * source	where the bytes come from
+     * Returns :
+     * int	the next code point, or LEDTEXT_END or LEDTEXT_WAIT like
+     *		LedTextSource::next()
+     */
+    int next(LedTextSource &source);
+};
+
+/*
+ * Produces the columns of a text one at a time, in the layout used by
+ * LedControl::printString: every character takes 6 columns, a blank one
+ * followed by the FONT_COLUMNS of its glyph. In proportional mode a
+ * character takes a blank column and only the non-blank columns of its
+ * glyph (see ledFontWidth), so narrow characters like 'I', '!' or '.' 
+ * take less room. The text is UTF-8, see ledUtf8Next(). The glyph of 
+ * the current character is looked up once, not for every column.
+ */
+class LedTextColumns {
+ private :
+    /* The text, it must stay valid while columns are taken from it */
+    const char *text;
+    /* If not 0 the characters come from here instead of text */
+    LedTextSource *source;
+    LedUtf8Decoder decoder;
+    /* true once source has run out of characters */
+    bool ended;
+    /* Number of bytes in text */
+    int length;
+    /* 
+     * The byte where the current character starts and its size. Outside 
+     * the text every blank column counts as a character of one byte.
+     */
+    int index;
+    byte size;
+    /* The column inside the cell of the character that next() returns */
+    int sub;
+    /* true if the columns are produced from the end of the text to the start */
+    bool reverse;
+    /* true if every character only takes the width of its glyph */
+    bool proportional;
+    /* The glyph of the character at index, in flash */
+    const byte *glyph;
+    /* The first column of the glyph that is shown and the width of the cell */
+    byte offset;
+    byte cell;
+
+    /* Move on to another character and look up its glyph */
+    void load(int index);
+
+ public:
+    LedTextColumns();
+
+    /* 
+     * Start producing the columns of a text.
+     * Params :
+     * text	the text, it is not copied
+     * length	number of bytes in text
+     * column	the first column to produce, column 0 is the blank 
+     *		column in front of the first character. Columns outside 
+     *		the text are blank.
+     * reverse	if true the columns are produced backwards
+     * proportional	if true every character takes the width of its glyph
+     */
+    void start(const char *text, int length, int column, bool reverse=false, 
+	       bool proportional=false);
+
+    /*
+     * Start producing the columns of the text coming from a source.
+     * Each character is taken from the source when its first column 
+     * is needed. After the end of the text the columns are blank.
+     * Params :
+     * source		where the characters come from
+     * proportional	if true every character takes the width of its glyph
+     */
+    void start(LedTextSource &source, bool proportional=false);
+
+    /*
+     * Returns :
+     * bool	true once a source has ended and all its columns were produced
+     */
+    bool isEnded() { return ended; }
+
+    /*
+     * Returns :
+     * byte	the next column, bit 0 is the top led
+     */
+    byte next();
+};
+
+/*
+ * Measure a text without drawing it.
+ * Params :
+ * text		the text
+ * length	number of bytes in text, -1 if it is unknown
+ * proportional	true for the width of a proportional text
+ * Returns :
+ * int	the number of columns of the text, including the blank column 
+ *	in front of the first character and the one after the last. 
+ *	That is also the number of frames it takes to scroll it by.
+ */
+int ledTextWidth(const char *text, int length=-1, bool proportional=false);
+
+#endif	//LedText.h
@@ -0,0 +1,120 @@
+/*
+ *    LedTransport.cpp - Transports that shift command data out to a chain
+ *    of MAX7219/MAX7221 devices for LedControl
+ *
+ *    Released under the same terms as LedControl.h
+ */
+
+#include "LedTransport.h"
+#include <SPI.h>
+
+LedBitBangTransport::LedBitBangTransport(int dataPin, int clkPin, int csPin) {
+    SPI_MOSI=dataPin;
+    SPI_CLK=clkPin;
+    SPI_CS=csPin;
+}
+
+void LedBitBangTransport::begin() {
+    pinMode(SPI_MOSI,OUTPUT);
+    pinMode(SPI_CLK,OUTPUT);
+    pinMode(SPI_CS,OUTPUT);
+    digitalWrite(SPI_CS,HIGH);
+}
+
+void LedBitBangTransport::transfer(const byte *data, int len) {
+    //enable the line 
+    digitalWrite(SPI_CS,LOW);
+    //Now shift out the data 
+    for(int i=0;i<len;i++)
+ 	shiftOut(SPI_MOSI,SPI_CLK,MSBFIRST,data[i]);
+    //latch the data onto the display
+    digitalWrite(SPI_CS,HIGH);
+}
+
+LedFastBitBangTransport::LedFastBitBangTransport(int dataPin, int clkPin, int csPin, byte padding) {
+    //the registers are looked up once, not for every bit
+    SPI_MOSI.attach(dataPin);
+    SPI_CLK.attach(clkPin);
+    SPI_CS.attach(csPin);
+    pins[0]=dataPin;
+    pins[1]=clkPin;
+    pins[2]=csPin;
+    this->padding=padding;
+}
+
+void LedFastBitBangTransport::begin() {
+    for(int i=0;i<3;i++)
+	pinMode(pins[i],OUTPUT);
+    SPI_CLK.low();
+    SPI_CS.high();
+}
+
+void LedFastBitBangTransport::transfer(const byte *data, int len) {
+#if defined(__AVR__)
+    //the port is shared with other pins, an interrupt must not change it while we modify it
+    byte sreg=SREG;
+    cli();
+#endif
+    SPI_CS.low();
+#if defined(__AVR__)
+    SREG=sreg;
+#endif
+    for(int i=0;i<len;i++) {
+	byte value=data[i];
+#if defined(__AVR__)
+	sreg=SREG;
+	cli();
+#endif
+	for(byte bit=0x80;bit!=0;bit>>=1) {
+	    if(value&bit)
+		SPI_MOSI.high();
+	    else
+		SPI_MOSI.low();
+	    //the MAX7219 samples DIN on the rising edge
+	    SPI_CLK.high();
+	    pad();
+	    SPI_CLK.low();
+	    pad();
+	}
+#if defined(__AVR__)
+	SREG=sreg;
+#endif
+    }
+    //latch the data onto the display
+#if defined(__AVR__)
+    sreg=SREG;
+    cli();
+#endif
+    SPI_CS.high();
+#if defined(__AVR__)
+    SREG=sreg;
+#endif
+}
+
+LedHardwareSpiTransport::LedHardwareSpiTransport(int csPin, unsigned long clockHz) {
+    SPI_CS=csPin;
+    clock=clockHz;
+}
+
+void LedHardwareSpiTransport::begin() {
+    pinMode(SPI_CS,OUTPUT);
+    digitalWrite(SPI_CS,HIGH);
+    SPI.begin();
+}
+
+void LedHardwareSpiTransport::transfer(const byte *data, int len) {
+    //the MAX7219 samples DIN on the rising edge of CLK
+    SPI.beginTransaction(SPISettings(clock,MSBFIRST,SPI_MODE0));
+    digitalWrite(SPI_CS,LOW);
+#if defined(ESP8266) || defined(ESP32)
+    //the whole chain buffer goes out in one call
+    SPI.writeBytes((uint8_t *)data,len);
+#else
+    //SPI.transfer(buf,len) would overwrite our buffer with the received bytes
+    for(int i=0;i<len;i++)
+	SPI.transfer(data[i]);
+#endif
+    //latch the data onto the display
+    digitalWrite(SPI_CS,HIGH);
+    SPI.endTransaction();
+}
@@ -0,0 +1,259 @@
+/*
+ *    LedTransport.h - Transports that shift command data out to a chain
+ *    of MAX7219/MAX7221 devices for LedControl
+ *
+ *    Released under the same terms as LedControl.h
+ */
+
+#ifndef LedTransport_h
+#define LedTransport_h
+
+#if (ARDUINO >= 100)
+#include <Arduino.h>
+#else
+#include <WProgram.h>
+#endif
+
+/*
+ * A transport moves a complete chain buffer to the devices.
+ * LedControl prepares one opcode/data pair for every device and
+ * hands the whole buffer over in a single call. 
+ */
+class LedTransport {
+ public:
+    /*
+     * Setup the pins or the bus used by this transport.
+     * Called once from the LedControl constructor.
+     */
+    virtual void begin()=0;
+
+    /* 
+     * Shift out a chain buffer and latch it onto the devices.
+     * Params :
+     * data	the bytes to send, data[0] is shifted out first. 
+     *		The opcode/data pair for the last device in the chain 
+     *		comes first, the pair for device 0 comes last.
+     * len	number of bytes in data (2 for each device)
+     */
+    virtual void transfer(const byte *data, int len)=0;
+};
+
+/*
+ * The original transport, every bit is clocked out with 
+ * digitalWrite/shiftOut. Works on any set of pins.
+ */
+class LedBitBangTransport : public LedTransport {
+ private :
+    /* Data is shifted out of this pin*/
+    int SPI_MOSI;
+    /* The clock is signaled on this pin */
+    int SPI_CLK;
+    /* This one is driven LOW for chip selectzion */
+    int SPI_CS;
+
+ public:
+    /* 
+     * Params :
+     * dataPin		pin on the Arduino where data gets shifted out
+     * clockPin		pin for the clock
+     * csPin		pin for selecting the device 
+     */
+    LedBitBangTransport(int dataPin, int clkPin, int csPin);
+
+    virtual void begin();
+    virtual void transfer(const byte *data, int len);
+};
+
+/*
+ * The output register and bit of a pin. Setting and clearing the pin
+ * is a single register write instead of a digitalWrite() call with its
+ * pin table lookups. Where the chip has registers that only set or 
+ * only clear pins (ESP8266, ESP32, SAMD) those are used, elsewhere the
+ * read-modify-write of the port runs with interrupts off. On the Linux
+ * host the pin is written with digitalWrite() so the simulator sees 
+ * every edge.
+ */
+#if defined(__AVR__)
+typedef volatile uint8_t LedPortRegister;
+typedef uint8_t LedPortMask;
+#else
+typedef volatile uint32_t LedPortRegister;
+typedef uint32_t LedPortMask;
+#endif
+
+class LedFastPin {
+ private :
+    /* The arduino pin number */
+    int pin;
+#if !defined(ARDUINO_HOST)
+    /* The output register of the pin and the bit inside it */
+    LedPortRegister *out;
+    LedPortMask mask;
+#endif
+#if defined(ESP32) || defined(ARDUINO_ARCH_SAMD)
+    /* The registers that only set or only clear the bits written as 1 */
+    LedPortRegister *set;
+    LedPortRegister *clear;
+#endif
+
+ public:
+    LedFastPin() : pin(-1) {}
+
+    /* 
+     * Look up the register of a pin, done once.
+     * Params :
+     * pin	the arduino pin number
+     */
+    void attach(int pin) {
+	this->pin=pin;
+#if defined(ARDUINO_HOST)
+#elif defined(ESP8266)
+	//GPIO16 sits in a register of its own
+	out=0;
+	mask=pin<16 ? (1UL << pin) : 0;
+#else
+	out=portOutputRegister(digitalPinToPort(pin));
+	mask=digitalPinToBitMask(pin);
+#endif
+#if defined(ESP32)
+	//the W1TS and W1TC registers follow the output register, a write to
+	//them can not undo what the other core or a task did to other pins
+	set=out+1;
+	clear=out+2;
+#elif defined(ARDUINO_ARCH_SAMD)
+	//OUT is followed by OUTCLR and OUTSET
+	clear=out+1;
+	set=out+2;
+#endif
+    }
+
+    void high() {
+#if defined(ARDUINO_HOST)
+	digitalWrite(pin,HIGH);
+#elif defined(ESP8266)
+	if(mask)
+	    GPOS=mask;
+	else
+	    digitalWrite(pin,HIGH);
+#elif defined(ESP32) || defined(ARDUINO_ARCH_SAMD)
+	*set=mask;
+#elif defined(__AVR__)
+	//LedFastBitBangTransport turns the interrupts off around this
+	*out|=mask;
+#else
+	//no set and clear registers we know of, an interrupt that writes
+	//the same port must not come between the read and the write
+	noInterrupts();
+	*out|=mask;
+	interrupts();
+#endif
+    }
+
+    void low() {
+#if defined(ARDUINO_HOST)
+	digitalWrite(pin,LOW);
+#elif defined(ESP8266)
+	if(mask)
+	    GPOC=mask;
+	else
+	    digitalWrite(pin,LOW);
+#elif defined(ESP32) || defined(ARDUINO_ARCH_SAMD)
+	*clear=mask;
+#elif defined(__AVR__)
+	*out&=~mask;
+#else
+	noInterrupts();
+	*out&=~mask;
+	interrupts();
+#endif
+    }
+};
+
+/*
+ * A bit-bang transport that writes the port registers directly. The
+ * pins are resolved to registers once, then whole chain buffers are 
+ * clocked out with plain register writes. Use it when the hardware 
+ * SPI pins are taken, it is many times faster than LedBitBangTransport.
+ */
+class LedFastBitBangTransport : public LedTransport {
+ private :
+    /* Data is shifted out of this pin*/
+    LedFastPin SPI_MOSI;
+    /* The clock is signaled on this pin */
+    LedFastPin SPI_CLK;
+    /* This one is driven LOW for chip selectzion */
+    LedFastPin SPI_CS;
+    /* The arduino pin numbers, for pinMode() in begin() */
+    int pins[3];
+    /* Number of extra wait loops after each clock edge */
+    byte padding;
+
+    /* Wait a little so the clock pulses don't get too short */
+    void pad() {
+	for(byte i=padding;i>0;i--)
+	    __asm__ __volatile__("nop");
+    }
+
+ public:
+    /* 
+     * Params :
+     * dataPin		pin on the Arduino where data gets shifted out
+     * clockPin		pin for the clock
+     * csPin		pin for selecting the device 
+     * padding		extra wait loops after each clock edge. The MAX7219
+     *			needs clock pulses of at least 50ns, fast boards 
+     *			(ESP8266 at 160MHz, ESP32) or long wires need some.
+     */
+    LedFastBitBangTransport(int dataPin, int clkPin, int csPin, byte padding=0);
+
+    virtual void begin();
+    virtual void transfer(const byte *data, int len);
+};
+
+/*
+ * Like LedBitBangTransport, but the pins are fixed at compile time
+ * so the transport takes no memory and can be created inside a 
+ * LedChain.
+ */
+template<int DATA, int CLK, int CS> class LedPins : public LedTransport {
+ public:
+    virtual void begin() {
+	pinMode(DATA,OUTPUT);
+	pinMode(CLK,OUTPUT);
+	pinMode(CS,OUTPUT);
+	digitalWrite(CS,HIGH);
+    }
+
+    virtual void transfer(const byte *data, int len) {
+	digitalWrite(CS,LOW);
+	for(int i=0;i<len;i++)
+	    shiftOut(DATA,CLK,MSBFIRST,data[i]);
+	digitalWrite(CS,HIGH);
+    }
+};
+
+/*
+ * Uses the SPI peripheral of the board. Data goes out on the 
+ * hardware MOSI and SCK pins (D7 and D5 on the ESP8266, 11 and 13 
+ * on the Uno), only the chip select pin can be choosen freely.
+ */
+class LedHardwareSpiTransport : public LedTransport {
+ private :
+    /* This one is driven LOW for chip selectzion */
+    int SPI_CS;
+    /* The bus clock in Hz */
+    unsigned long clock;
+
+ public:
+    /* 
+     * Params :
+     * csPin		pin for selecting the device 
+     * clockHz		clock of the bus, the MAX7219 handles up to 10MHz
+     */
+    LedHardwareSpiTransport(int csPin, unsigned long clockHz=10000000);
+
+    virtual void begin();
+    virtual void transfer(const byte *data, int len);
+};
+
+#endif	//LedTransport.h
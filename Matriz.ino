@@ -1,12 +1,58 @@
 
 #include "LedControl.h"     //simpre incluimos la libreria de control 
+#include "LedScroll.h"      //para mover el texto sin bloquear el loop
+#include "LedAnimation.h"   //para animaciones guardadas en la flash
 
 const byte DIN      = D5;   //Lo conectamos en din
 const byte CS       = D6;   //Lo conectamos a Load (cs)
 const byte CLK      = D7;   //Lo conectarmos a CLK 
 const byte QTD_DISP =  1;   //El nuemro de matriz con controlador M72XX
 
-LedControl ledMatrix = LedControl(DIN, CLK, CS, QTD_DISP);
+LedControl ledMatrix(DIN, CLK, CS, QTD_DISP);
+
+//Con el SPI por hardware (DIN en D7 y CLK en D5) el bus va mucho mas rapido, descomentar para probar
+//LedHardwareSpiTransport bus(CS, 10000000);
+//LedControl ledMatrix(bus, QTD_DISP);
+
+//Con los mismos pines, escribiendo directo en los registros del puerto en vez de digitalWrite
+//LedFastBitBangTransport bus(DIN, CLK, CS);
+//LedControl ledMatrix(bus, QTD_DISP);
+
+//Para cadenas de mas de 8 matrices el largo se fija al compilar, por ejemplo 16
+//LedChain<16> ledMatrix(DIN, CLK, CS);
+
+LedScroll scroll(ledMatrix, 0, 0);
+//Con varias matrices el texto puede pasar de una a otra, descomentar para probar
+//LedScroll scroll(LedCanvas(ledMatrix), 0);
+
+char texto[] = "Adiowis"; //Texto a mostrar en la matriz
+//char texto[] = "¡Adiós, señor! 25°C"; //Los acentos, la ñ y el ° también se ven, el archivo está en UTF-8
+
+//Texto a mostrar en la matriz (Ejemplo de conversion de string a Char, descomentar para probar
+//String enviar = "Holiwis";  
+//enviar.toCharArray(texto,50);
+
+//Para mostrar lo que llega por el puerto serie a medida que llega, sin guardar el texto completo
+//LedStreamSource serie(Serial, '\n');
+//scroll.start(serie, 50);
+
+//Un corazon que late, guardado en la flash con solo las filas que cambian de un cuadro al otro (ver LedAnimation.h)
+//Descomentar para probar, con animacion.start(latido, true); en el setup y animacion.update(); en el loop en vez del scroll
+//const byte latido[] PROGMEM = {
+//  1,                                                          //una matriz
+//  LEDANIM_FRAME(600), 0x7E, 0x0C,0x1C,0x38,0x38,0x1C,0x0C,    //chico, las filas 1 a 6
+//  LEDANIM_FRAME(300), 0xFF, 0x0C,0x1E,0x3E,0x7C,0x7C,0x3E,0x1E,0x0C, //grande
+//  LEDANIM_END
+//};
+//LedAnimation animacion(ledMatrix, 0);
+
+//Para que el loop no espere al bus: las escrituras quedan en una cola y una interrupcion de timer las envia.
+//Con el Ticker del ESP8266, en el setup: ledMatrix.setQueued(true); refresco.attach_ms(1, refrescar);
+//Ticker refresco;
+//void refrescar() { ledMatrix.service(2); }  //a lo sumo 2 envios por interrupcion
+
+char sentido = '>';       //Sentido de la ultima pasada
+unsigned long fin = 0;    //Ultimo momento en que la pasada seguia en curso
 
 void setup() {
   
@@ -18,28 +64,31 @@ void setup() {
   
   // y borramos la pantalla
   ledMatrix.clearDisplay(0);     //borrar pantalla '0'
+
+  // Ahorro de energía: apaga el display cuando está en blanco y limita el brillo a 24 leds a tope
+  //ledMatrix.setPowerSaving(true, 24);
 }
 
 void loop(){
 
-  char texto[] = "Adiowis"; //Texto a mostrar en la matriz
+  //Cerca de reles o motores el ruido puede alterar los registros de la matriz: reescribir uno por vuelta
+  //los corrige sin que se note, descomentar para probar
+  //ledMatrix.scrub(1);
 
-  //Texto a mostrar en la matriz (Ejemplo de conversion de string a Char, descomentar para probar
-  //String enviar = "Holiwis";  
-  //enviar.toCharArray(texto,50);
+  //update() vuelve enseguida, el loop queda libre para leer sensores o el serial mientras el texto avanza
+  if (scroll.update()){
+    fin = millis();
+    return;
+  }
 
-  //Muestra texto de izquiera a derecha
-  ledMatrix.clearDisplay(0);
-  ledMatrix.printStringScroll(0, 0, texto, 50, '<');
-  delay(500);
+  //Espera medio segundo entre una pasada y la otra, sin delay()
+  if (millis() - fin < 500){
+    return;
+  }
 
-  //Muestra el texto de derecha a izquierda
+  //Alterna el sentido: '<' de izquierda a derecha y '>' de derecha a izquierda
+  sentido = (sentido == '<') ? '>' : '<';
   ledMatrix.clearDisplay(0);
-  ledMatrix.printStringScroll(0, 0, texto, 50, '>');
-  delay(500);
+  scroll.start(texto, 50, sentido);
 
 }
-
-
-
-
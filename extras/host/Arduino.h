@@ -0,0 +1,64 @@
+/*
+ *    Arduino.h - Minimal stand-in for the Arduino core so LedControl
+ *    can be compiled and run on a Linux host
+ *
+ *    Released under the same terms as LedControl.h
+ */
+
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include "binary.h"
+
+/* Code that needs to know it runs on the Linux host can check this */
+#define ARDUINO_HOST 1
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT  0x0
+#define OUTPUT 0x1
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+/* There is no separate flash on the host */
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+
+/* The pins of a NodeMCU board as used in Matriz.ino */
+#define D5 14
+#define D6 12
+#define D7 13
+
+/* The hardware SPI pins of the ESP8266 */
+static const uint8_t MOSI = D7;
+static const uint8_t SCK  = D5;
+
+/* Only what LedStreamSource needs */
+class Stream {
+ public:
+    virtual ~Stream() {}
+    virtual int available()=0;
+    virtual int read()=0;
+    virtual int peek()=0;
+};
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+void shiftOut(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t val);
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+
+#endif	//Arduino.h
@@ -0,0 +1,76 @@
+/*
+ *    ArduinoHost.cpp - Minimal stand-in for the Arduino core so LedControl
+ *    can be compiled and run on a Linux host
+ *
+ *    Released under the same terms as LedControl.h
+ */
+
+#include "ArduinoHost.h"
+#include "SPI.h"
+#include <time.h>
+
+SPIClass SPI;
+
+/* The level last written to every pin */
+static uint8_t pinLevel[256];
+/* Who wants to know about pin writes */
+static HostPinListener *listeners[8];
+
+void hostAttach(HostPinListener *listener) {
+    for(int i=0;i<8;i++) {
+	if(listeners[i]==0) {
+	    listeners[i]=listener;
+	    return;
+	}
+    }
+}
+
+void hostDetach(HostPinListener *listener) {
+    for(int i=0;i<8;i++) {
+	if(listeners[i]==listener)
+	    listeners[i]=0;
+    }
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+    pinLevel[pin]=val ? HIGH : LOW;
+    for(int i=0;i<8;i++) {
+	if(listeners[i]!=0)
+	    listeners[i]->pinWritten(pin,pinLevel[pin]);
+    }
+}
+
+int digitalRead(uint8_t pin) {
+    return pinLevel[pin];
+}
+
+void shiftOut(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t val) {
+    for(int i=0;i<8;i++) {
+	if(bitOrder==LSBFIRST)
+	    digitalWrite(dataPin,(val>>i)&1);
+	else
+	    digitalWrite(dataPin,(val>>(7-i))&1);
+	digitalWrite(clockPin,HIGH);
+	digitalWrite(clockPin,LOW);
+    }
+}
+
+unsigned long micros() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+    return (unsigned long)ts.tv_sec*1000000UL+ts.tv_nsec/1000;
+}
+
+unsigned long millis() {
+    return micros()/1000;
+}
+
+void delay(unsigned long ms) {
+    struct timespec ts;
+    ts.tv_sec=ms/1000;
+    ts.tv_nsec=(ms%1000)*1000000L;
+    nanosleep(&ts,0);
+}
@@ -0,0 +1,31 @@
+/*
+ *    ArduinoHost.h - Hooks into the Arduino stand-in of the Linux host
+ *
+ *    Released under the same terms as LedControl.h
+ */
+
+#ifndef ArduinoHost_h
+#define ArduinoHost_h
+
+#include "Arduino.h"
+
+/*
+ * Gets told about every digitalWrite(), including the ones done by
+ * shiftOut() and the SPI stand-in.
+ */
+class HostPinListener {
+ public:
+    virtual ~HostPinListener() {}
+    /* 
+     * Params :
+     * pin	the pin that was written
+     * level	HIGH or LOW
+     */
+    virtual void pinWritten(uint8_t pin, uint8_t level)=0;
+};
+
+/* Start and stop sending pin writes to a listener, up to 8 at a time */
+void hostAttach(HostPinListener *listener);
+void hostDetach(HostPinListener *listener);
+
+#endif	//ArduinoHost.h
@@ -0,0 +1,108 @@
+/*
+ *    LedBench.cpp - Measures the bus traffic and the host CPU time of 
+ *    the LedControl API on the Linux host
+ *
+ *    Released under the same terms as LedControl.h
+ */
+
+#include "LedControl.h"
+#include "LedScroll.h"
+#include "Max7219Sim.h"
+#include <stdio.h>
+#include <time.h>
+
+#define DIN D5
+#define CLK D7
+#define CS  D6
+
+/* How often every operation is repeated for the time measurement */
+static int repeat=200;
+
+static double nowNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+    return ts.tv_sec*1e9+ts.tv_nsec;
+}
+
+/* Print a line of the table, the bus counters come from the simulator */
+static void report(int devices, const char *operation, Max7219Sim &sim, double ns) {
+    printf("%d,%s,%lu,%lu,%lu,%.0f\n",devices,operation,sim.clocks,sim.clocks/8,sim.latches,ns);
+}
+
+/*
+ * Run an operation once with the simulator counting, then time it 
+ * without the simulator so only the library is measured.
+ */
+template<class Op> static void measure(int devices, const char *operation, Max7219Sim &sim, Op op) {
+    double start;
+
+    sim.resetCounters();
+    op(0);
+    hostDetach(&sim);
+    start=nowNs();
+    for(int i=0;i<repeat;i++)
+	op(i+1);
+    report(devices,operation,sim,(nowNs()-start)/repeat);
+    hostAttach(&sim);
+}
+
+template<int N> static void bench() {
+    Max7219Sim sim(N,DIN,CLK,CS);
+    double start;
+
+    //the constructor is timed apart, it needs a new object every time
+    sim.resetCounters();
+    LedChain<N> lc(DIN,CLK,CS);
+    hostDetach(&sim);
+    start=nowNs();
+    for(int i=0;i<repeat;i++)
+	LedChain<N> other(DIN,CLK,CS);
+    report(N,"init",sim,(nowNs()-start)/repeat);
+    hostAttach(&sim);
+
+    //every call changes the display, rows that stay the same are not sent
+    //and would measure nothing. The rows are filled through the handle,
+    //which only writes the led-status, so clearDisplay sends all 8
+    LedDevice last=lc.device(N-1);
+    measure(N,"clearDisplay",sim,[&](int i) { 
+	for(int row=0;row<8;row++)
+	    last.setRow(row,0xFF);
+	lc.clearDisplay(N-1); 
+    });
+    //even calls switch a led on, odd ones switch it off again
+    measure(N,"setLed",sim,[&](int i) { lc.setLed(N-1,(i>>1)&7,(i>>4)&7,!(i&1)); });
+    //a row gets a value 8 higher than the last time
+    measure(N,"setRow",sim,[&](int i) { lc.setRow(N-1,i&7,i+1); });
+    measure(N,"setColumn",sim,[&](int i) { lc.setColumn(N-1,i&7,i|1); });
+    measure(N,"printChar",sim,[&](int i) { lc.printChar(N-1,0,'A'+(i%26)); });
+    measure(N,"printString",sim,[&](int i) { lc.printString(N-1,-(i%40),"Hola mundo!"); });
+    lc.clearDisplay(N-1);
+
+    //one frame of a scroll, with the frame interval at 0 every update() is a new frame
+    LedScroll scroll(lc,N-1,0);
+    scroll.start("Hola mundo, el texto es largo pero cada cuadro cuesta lo mismo",0,'<');
+    measure(N,"scrollFrame",sim,[&](int i) { 
+	if(!scroll.update())
+	    scroll.start("Hola mundo, el texto es largo pero cada cuadro cuesta lo mismo",0,'<');
+    });
+
+    //the same over all modules of the chain
+    LedScroll wide(LedCanvas(lc),0);
+    wide.start("Hola mundo, el texto es largo pero cada cuadro cuesta lo mismo",0,'<');
+    measure(N,"canvasScrollFrame",sim,[&](int i) { 
+	if(!wide.update())
+	    wide.start("Hola mundo, el texto es largo pero cada cuadro cuesta lo mismo",0,'<');
+    });
+}
+
+int main(int argc, char *argv[]) {
+    if(argc>1)
+	repeat=atoi(argv[1]);
+    printf("devices,operation,clocks,bytes,latches,ns\n");
+    bench<1>();
+    bench<4>();
+    bench<8>();
+    bench<16>();
+    bench<32>();
+    return 0;
+}
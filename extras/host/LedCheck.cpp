@@ -0,0 +1,250 @@
+/*
+ *    LedCheck.cpp - Checks the number of latches the LedControl API
+ *    promises against the simulated chain on the Linux host
+ *
+ *    Released under the same terms as LedControl.h
+ */
+
+#include "LedControl.h"
+#include "Max7219Sim.h"
+#include <stdio.h>
+#include <vector>
+
+#define DIN D5
+#define CLK D7
+#define CS  D6
+
+/* Number of checks that failed */
+static int failed=0;
+
+/* Print the result of a check, the failed ones are counted */
+static void check(bool ok, const char *what) {
+    printf("%s %s\n",ok ? "ok  " : "FAIL",what);
+    if(!ok)
+	failed++;
+}
+
+/* Deferred mode, a redraw of the chain is 8 latches and rows that did not change are skipped */
+static void checkFlush() {
+    Max7219Sim sim(8,DIN,CLK,CS);
+    LedControl lc(DIN,CLK,CS,8);
+    bool same=true;
+
+    lc.setDeferred(true);
+    sim.resetCounters();
+    for(int addr=0;addr<8;addr++)
+	for(int row=0;row<8;row++)
+	    lc.setRow(addr,row,addr*8+row+1);
+    lc.flush();
+    check(sim.latches==8,"flush() of 8 devices x 8 rows takes 8 latches");
+    for(int addr=0;addr<8;addr++)
+	for(int row=0;row<8;row++)
+	    same=same && sim.getRegister(addr,row+1)==addr*8+row+1;
+    check(same,"flush() writes every row");
+    sim.resetCounters();
+    lc.setRow(0,0,1);
+    lc.clearDisplay(7);
+    lc.clearDisplay(7);
+    lc.flush();
+    check(sim.latches==8,"a cleared device costs 8 latches once");
+    sim.resetCounters();
+    lc.setRow(0,0,1);
+    lc.clearDisplay(7);
+    lc.flush();
+    check(sim.latches==0,"rows that did not change are not sent");
+}
+
+/* LedFastBitBangTransport clocks the chain like the plain bit-bang transport */
+static void checkFastBitBang() {
+    Max7219Sim sim(4,DIN,CLK,CS);
+    LedFastBitBangTransport bus(DIN,CLK,CS);
+    LedControl lc(bus,4);
+    bool same=true;
+
+    check(sim.latches==12,"init through the fast transport takes 12 latches");
+    sim.resetCounters();
+    for(int addr=0;addr<4;addr++)
+	lc.setRow(addr,addr+1,0xA0+addr);
+    check(sim.latches==4 && sim.clocks==4*4*16,"every setRow latches the whole chain once");
+    for(int addr=0;addr<4;addr++)
+	same=same && sim.getRegister(addr,addr+2)==0xA0+addr;
+    check(same,"the fast transport writes the right device");
+}
+
+/* Double buffering keeps pending rows, the deferred mode and the device handles */
+static void checkDoubleBuffer() {
+    Max7219Sim sim(2,DIN,CLK,CS);
+    LedControl lc(DIN,CLK,CS,2);
+    LedDevice first=lc.device(0);
+
+    lc.setDeferred(true);
+    lc.setRow(0,2,0xAA);
+    lc.setDoubleBuffer(true);
+    lc.present();
+    check(sim.getRegister(0,3)==0xAA,"a row waiting before setDoubleBuffer(true) is sent");
+    sim.resetCounters();
+    first.setRow(1,0x55);
+    check(sim.latches==0,"a handle from before setDoubleBuffer(true) draws on the back buffer");
+    lc.present();
+    check(sim.getRegister(0,2)==0x55 && sim.latches==1,"present() sends what the old handle drew");
+    lc.setDoubleBuffer(false);
+    check(lc.isDeferred(),"setDoubleBuffer(false) keeps the deferred mode of the sketch");
+    lc.setDeferred(false);
+    lc.beginTransaction();
+    lc.setDoubleBuffer(true);
+    lc.setDoubleBuffer(false);
+    sim.resetCounters();
+    lc.setRow(1,0,0x0F);
+    check(sim.latches==0,"setDoubleBuffer(false) in a transaction keeps the writes for the commit");
+    lc.commitTransaction();
+    check(sim.getRegister(1,1)==0x0F && !lc.isDeferred(),"commitTransaction() sends them and ends deferred mode");
+}
+
+/* Queued mode coalesces writes to the same register and packs a latch per row */
+static void checkQueue() {
+    Max7219Sim sim(32,DIN,CLK,CS);
+    LedChain<32> lc(DIN,CLK,CS);
+    int latches=0, sent;
+    bool same=true;
+
+    check(lc.setQueued(true),"setQueued(true) on 32 devices");
+    sim.resetCounters();
+    lc.setRow(4,2,0x11);
+    lc.setRow(4,2,0x22);
+    check(sim.latches==0,"queued writes wait for service()");
+    check(lc.service(8)==1 && sim.getRegister(4,3)==0x22,"two writes to a register go out once, with the last value");
+    sim.resetCounters();
+    for(int addr=0;addr<32;addr++) {
+	for(int row=0;row<8;row++)
+	    lc.setRow(addr,row,addr+row+1);
+	lc.setIntensity(addr,addr&15);
+    }
+    while((sent=lc.service(3))>0)
+	latches+=sent;
+    check(latches==9 && sim.latches==9,"a redraw of 32 devices plus their intensity takes 9 latches");
+    for(int addr=0;addr<32;addr++)
+	for(int row=0;row<8;row++)
+	    same=same && sim.getRegister(addr,row+1)==addr+row+1;
+    check(same,"service() writes every row");
+    lc.setRow(0,0,0x81);
+    lc.setQueued(false);
+    check(sim.getRegister(0,1)==0x81,"setQueued(false) sends what is left");
+}
+
+/* init() and the broadcast variants, 12 latches for any chain */
+static void checkInit() {
+    Max7219Sim sim(16,DIN,CLK,CS);
+    LedChain<16> lc(DIN,CLK,CS);
+
+    check(sim.latches==12,"init of 16 devices takes 12 latches");
+    sim.resetCounters();
+    lc.shutdownAll(false);
+    lc.setIntensityAll(7);
+    check(sim.latches==2,"shutdownAll and setIntensityAll take a latch each");
+    check(sim.getRegister(15,10)==7 && sim.getRegister(0,12)==1,"the broadcasts reach every device");
+}
+
+/* A transaction packs writes for different devices and registers into one latch */
+static void checkTransaction() {
+    Max7219Sim sim(6,DIN,CLK,CS);
+    LedControl lc(DIN,CLK,CS,6);
+    int latches;
+
+    sim.resetCounters();
+    lc.beginTransaction();
+    lc.setIntensity(2,9);
+    lc.setRow(5,3,0x5A);
+    lc.shutdown(0,false);
+    latches=lc.commitTransaction();
+    check(latches==1 && sim.latches==1,"intensity, row and shutdown on 3 devices share one latch");
+    check(sim.getRegister(2,10)==9 && sim.getRegister(5,4)==0x5A && sim.getRegister(0,12)==1,
+	  "the transaction writes all three registers");
+    sim.resetCounters();
+    lc.beginTransaction();
+    lc.setIntensityAll(3);
+    lc.setRow(1,0,0xFF);
+    lc.setRow(1,1,0xFF);
+    latches=lc.commitTransaction();
+    check(latches==3 && sim.latches==3,"commitTransaction() reports the writes of the busiest device");
+    lc.setQueued(true);
+    lc.beginTransaction();
+    lc.setRow(0,0,0x81);
+    lc.setRow(0,1,0x81);
+    check(lc.commitTransaction()==2,"commitTransaction() in queued mode reports the latches service() needs");
+    lc.setQueued(false);
+    check(sim.getRegister(0,1)==0x81 && sim.getRegister(0,2)==0x81,"setQueued(false) sends what is left");
+}
+
+/* Send a buffer through the pins of the chain, like noise on the wires would */
+static void corrupt(int devices, byte opcode, byte data) {
+    LedBitBangTransport noise(DIN,CLK,CS);
+    std::vector<byte> buffer(devices*2);
+
+    for(int i=0;i<devices;i++) {
+	buffer[i*2]=opcode;
+	buffer[i*2+1]=data;
+    }
+    noise.transfer(&buffer[0],devices*2);
+}
+
+/* scrub() rewrites the whole chain in 13 latches */
+static void checkScrub() {
+    Max7219Sim sim(4,DIN,CLK,CS);
+    LedControl lc(DIN,CLK,CS,4);
+    int latches=0;
+    bool same=true;
+
+    lc.shutdownAll(false);
+    for(int addr=0;addr<4;addr++)
+	for(int row=0;row<8;row++)
+	    lc.setRow(addr,row,0x0F+addr+row);
+    corrupt(4,3,0xEE);
+    corrupt(4,11,1);
+    corrupt(4,12,0);
+    sim.resetCounters();
+    while(latches<13)
+	latches+=lc.scrub(1);
+    check(latches==13 && sim.latches==13,"scrub() refreshes the chain in 13 latches");
+    for(int addr=0;addr<4;addr++) {
+	for(int row=0;row<8;row++)
+	    same=same && sim.getRegister(addr,row+1)==0x0F+addr+row;
+	same=same && sim.getRegister(addr,11)==7 && sim.getRegister(addr,12)==1;
+    }
+    check(same,"scrub() restores corrupted rows, scan limit and shutdown");
+}
+
+/* The power manager shuts down blank devices and trims scan limit and intensity */
+static void checkPower() {
+    Max7219Sim sim(2,DIN,CLK,CS);
+    LedControl lc(DIN,CLK,CS,2);
+
+    lc.shutdownAll(false);
+    lc.setIntensityAll(15);
+    lc.setPowerSaving(true);
+    check(sim.getRegister(0,12)==0 && sim.getRegister(1,12)==0,"blank devices are shut down");
+    lc.setRow(1,0,0x01);
+    check(sim.getRegister(1,12)==1 && sim.getRegister(1,11)==3 && sim.getRegister(1,10)==7,
+	  "a device wakes up with scan limit 3 and the intensity scaled down");
+    check(sim.getRegister(0,12)==0,"the other device stays shut down");
+    lc.setRow(1,7,0xFF);
+    check(sim.getRegister(1,11)==7 && sim.getRegister(1,10)==15,"the last row brings back the full scan limit");
+    lc.setPowerSaving(true,16);
+    for(int row=0;row<8;row++)
+	lc.setRow(0,row,0xFF);
+    check(sim.getRegister(0,10)==3,"64 lit leds with a budget of 16 get intensity 3");
+    lc.setPowerSaving(false);
+    check(sim.getRegister(0,10)==15 && sim.getRegister(1,11)==7,"switching it off restores the values of the sketch");
+}
+
+int main() {
+    checkFlush();
+    checkFastBitBang();
+    checkDoubleBuffer();
+    checkQueue();
+    checkInit();
+    checkTransaction();
+    checkScrub();
+    checkPower();
+    printf("%d failed\n",failed);
+    return failed>0 ? 1 : 0;
+}
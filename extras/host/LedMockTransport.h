@@ -0,0 +1,66 @@
+/*
+ *    LedMockTransport.h - A transport for the Linux host that records
+ *    what would have been sent to a chain of MAX7219/MAX7221 devices
+ *
+ *    Released under the same terms as LedControl.h
+ */
+
+#ifndef LedMockTransport_h
+#define LedMockTransport_h
+
+#include "LedTransport.h"
+#include <vector>
+
+class LedMockTransport : public LedTransport {
+ public:
+    /* 
+     * Params :
+     * numDevices	number of devices in the simulated chain
+     */
+    LedMockTransport(int numDevices=8) 
+	: begun(false), latches(0), bytes(0), reg(numDevices*16,0) {}
+
+    virtual void begin() { begun=true; }
+
+    virtual void transfer(const byte *data, int len) {
+	latches++;
+	bytes+=len;
+	last.assign(data,data+len);
+	//data[0] is shifted out first, so it ends up in the last device
+	int n=len/2;
+	for(int addr=0;addr<n && addr<getDeviceCount();addr++) {
+	    const byte *slot=data+(n-1-addr)*2;
+	    if(slot[0]!=0)
+		reg[addr*16+(slot[0]&0x0F)]=slot[1];
+	}
+    }
+
+    /* Number of devices in the simulated chain */
+    int getDeviceCount() const { return reg.size()/16; }
+
+    /* 
+     * The value last written to a register of a device.
+     * Params :
+     * addr	the device, 0 is the first in the chain
+     * opcode	the register (1..8 for the digits)
+     */
+    byte getRegister(int addr, int opcode) const { return reg[addr*16+opcode]; }
+
+    /* Forget the counters, the register contents are kept */
+    void resetCounters() { latches=0; bytes=0; }
+
+    /* true once begin() was called */
+    bool begun;
+    /* Number of CS cycles */
+    unsigned long latches;
+    /* Number of bytes shifted out */
+    unsigned long bytes;
+    /* The chain buffer of the last transfer */
+    std::vector<byte> last;
+
+ private :
+    /* 16 registers for every device */
+    std::vector<byte> reg;
+};
+
+#endif	//LedMockTransport.h
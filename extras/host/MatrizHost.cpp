@@ -0,0 +1,39 @@
+/*
+ *    MatrizHost.cpp - Runs Matriz.ino on the Linux host against a
+ *    simulated chain and prints every frame that reaches the matrix
+ *
+ *    Released under the same terms as LedControl.h
+ */
+
+#include "Max7219Sim.h"
+#include <stdio.h>
+#include <string.h>
+
+//created before the LedControl of the sketch so it sees the startup
+static Max7219Sim sim(1,D5,D7,D6);
+
+#include "../../Matriz.ino"
+
+int main(int argc, char *argv[]) {
+    unsigned long runFor=argc>1 ? strtoul(argv[1],0,10) : 3000;
+    bool pbm=argc>2 && strcmp(argv[2],"pbm")==0;
+    unsigned long seen=0;
+    unsigned long start;
+
+    setup();
+    start=millis();
+    while(millis()-start<runFor) {
+	loop();
+	if(sim.latches!=seen) {
+	    seen=sim.latches;
+	    if(pbm)
+		sim.dumpPbm(stdout);
+	    else {
+		printf("%lu ms, %lu latches\n",millis()-start,seen);
+		sim.dumpText(stdout);
+	    }
+	}
+	delay(1);
+    }
+    return 0;
+}
@@ -0,0 +1,85 @@
+/*
+ *    Max7219Sim.cpp - Simulates a chain of MAX7219/MAX7221 devices from
+ *    the pin writes of the Linux host
+ *
+ *    Released under the same terms as LedControl.h
+ */
+
+#include "Max7219Sim.h"
+
+//the registers of the MAX7219 that change what is visible
+#define REG_SCANLIMIT   11
+#define REG_SHUTDOWN    12
+#define REG_DISPLAYTEST 15
+
+Max7219Sim::Max7219Sim(int numDevices, int dataPin, int clkPin, int csPin) 
+    : clocks(0), latches(0), numDevices(numDevices), dataPin(dataPin), 
+      clkPin(clkPin), csPin(csPin), din(LOW), clk(LOW), cs(HIGH),
+      shift(numDevices,0), reg(numDevices*16,0) {
+    hostAttach(this);
+}
+
+Max7219Sim::~Max7219Sim() {
+    hostDetach(this);
+}
+
+void Max7219Sim::pinWritten(uint8_t pin, uint8_t level) {
+    if(pin==dataPin)
+	din=level;
+    if(pin==clkPin) {
+	if(level==HIGH && clk==LOW && cs==LOW) {
+	    //the chain is one long shift register
+	    uint8_t in=din;
+	    for(int addr=0;addr<numDevices;addr++) {
+		uint8_t out=(shift[addr]>>15)&1;
+		shift[addr]=(shift[addr]<<1)|in;
+		in=out;
+	    }
+	    clocks++;
+	}
+	clk=level;
+    }
+    if(pin==csPin) {
+	if(level==HIGH && cs==LOW) {
+	    for(int addr=0;addr<numDevices;addr++) {
+		int opcode=(shift[addr]>>8)&0x0F;
+		//register 0 is the no-op
+		if(opcode!=0)
+		    reg[addr*16+opcode]=shift[addr]&0xFF;
+	    }
+	    latches++;
+	}
+	cs=level;
+    }
+}
+
+bool Max7219Sim::isLit(int addr, int col, int row) const {
+    if(getRegister(addr,REG_DISPLAYTEST)&1)
+	return true;
+    if((getRegister(addr,REG_SHUTDOWN)&1)==0)
+	return false;
+    if(col>(getRegister(addr,REG_SCANLIMIT)&7))
+	return false;
+    return (getRegister(addr,col+1)>>row)&1;
+}
+
+void Max7219Sim::dumpText(FILE *out) const {
+    for(int row=0;row<8;row++) {
+	for(int addr=0;addr<numDevices;addr++) {
+	    for(int col=0;col<8;col++)
+		fputc(isLit(addr,col,row) ? '#' : '.',out);
+	    fputc(addr+1<numDevices ? ' ' : '\n',out);
+	}
+    }
+}
+
+void Max7219Sim::dumpPbm(FILE *out) const {
+    fprintf(out,"P1\n%d 8\n",numDevices*8);
+    for(int row=0;row<8;row++) {
+	for(int addr=0;addr<numDevices;addr++) {
+	    for(int col=0;col<8;col++)
+		fputs(isLit(addr,col,row) ? "1 " : "0 ",out);
+	}
+	fputc('\n',out);
+    }
+}
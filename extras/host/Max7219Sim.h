@@ -0,0 +1,84 @@
+/*
+ *    Max7219Sim.h - Simulates a chain of MAX7219/MAX7221 devices from
+ *    the pin writes of the Linux host
+ *
+ *    Released under the same terms as LedControl.h
+ */
+
+#ifndef Max7219Sim_h
+#define Max7219Sim_h
+
+#include "ArduinoHost.h"
+#include <stdio.h>
+#include <vector>
+
+/*
+ * Watches the DIN, CLK and LOAD (CS) pins of a chain. While LOAD is 
+ * low every rising edge of CLK shifts DIN into the 16 bit shift 
+ * register of device 0, the bit falling out of a device goes into the
+ * next one. The rising edge of LOAD copies every shift register into
+ * the register it addresses, just like the real chips.
+ *
+ * The matrix of a device is shown like LedControl::printChar draws:
+ * digit register 1..8 is column 0..7, bit 0 is the top row.
+ */
+class Max7219Sim : public HostPinListener {
+ public:
+    /* 
+     * Params :
+     * numDevices	number of devices in the chain
+     * dataPin		pin connected to DIN of device 0
+     * clkPin		pin connected to CLK
+     * csPin		pin connected to LOAD
+     */
+    Max7219Sim(int numDevices, int dataPin, int clkPin, int csPin);
+    virtual ~Max7219Sim();
+
+    virtual void pinWritten(uint8_t pin, uint8_t level);
+
+    /* Number of devices in the chain */
+    int getDeviceCount() const { return numDevices; }
+
+    /* The value of a register, opcode 1..8 are the digits */
+    byte getRegister(int addr, int opcode) const { return reg[addr*16+(opcode&0x0F)]; }
+
+    /* 
+     * The state of a led as it would be visible, taking shutdown, 
+     * display test and scan limit into account.
+     * Params :
+     * addr	the device
+     * col	the column, digit register col+1
+     * row	the row, bit row of the register
+     */
+    bool isLit(int addr, int col, int row) const;
+
+    /* Print the matrices side by side, device 0 on the left, '#' for a lit led */
+    void dumpText(FILE *out) const;
+
+    /* Write the matrices as a plain (P1) PBM image, device 0 on the left */
+    void dumpPbm(FILE *out) const;
+
+    /* Forget the counters, the registers are kept */
+    void resetCounters() { clocks=0; latches=0; }
+
+    /* Number of rising CLK edges while LOAD was low */
+    unsigned long clocks;
+    /* Number of rising LOAD edges */
+    unsigned long latches;
+
+ private :
+    int numDevices;
+    int dataPin;
+    int clkPin;
+    int csPin;
+    /* The current level of the three pins */
+    uint8_t din;
+    uint8_t clk;
+    uint8_t cs;
+    /* The 16 bit shift register of every device */
+    std::vector<uint16_t> shift;
+    /* 16 registers for every device */
+    std::vector<byte> reg;
+};
+
+#endif	//Max7219Sim.h
@@ -0,0 +1,56 @@
+/*
+ *    SPI.h - Stand-in for the Arduino SPI library on a Linux host.
+ *    Every byte written to the bus is kept in a buffer and clocked out
+ *    on the MOSI and SCK pins, where a simulator can pick it up.
+ *
+ *    Released under the same terms as LedControl.h
+ */
+
+#ifndef SPI_h
+#define SPI_h
+
+#include "Arduino.h"
+#include <vector>
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x04
+#define SPI_MODE2 0x08
+#define SPI_MODE3 0x0C
+
+class SPISettings {
+ public:
+    SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode)
+	: clock(clock), bitOrder(bitOrder), dataMode(dataMode) {}
+    uint32_t clock;
+    uint8_t bitOrder;
+    uint8_t dataMode;
+};
+
+class SPIClass {
+ public:
+    SPIClass() : clock(0), transactions(0) {}
+    void begin() {}
+    void end() {}
+    void beginTransaction(SPISettings settings) { clock=settings.clock; transactions++; }
+    void endTransaction() {}
+    uint8_t transfer(uint8_t data) { 
+	written.push_back(data); 
+	shiftOut(MOSI,SCK,MSBFIRST,data);
+	return 0; 
+    }
+    void writeBytes(const uint8_t *data, uint32_t size) { 
+	for(uint32_t i=0;i<size;i++)
+	    transfer(data[i]);
+    }
+
+    /* The clock of the last transaction */
+    uint32_t clock;
+    /* Number of transactions started */
+    unsigned long transactions;
+    /* All bytes written to the bus so far */
+    std::vector<uint8_t> written;
+};
+
+extern SPIClass SPI;
+
+#endif	//SPI.h